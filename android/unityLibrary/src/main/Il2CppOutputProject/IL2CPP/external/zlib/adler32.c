@@ -57,6 +57,168 @@
 #  define MOD63(a) a %= BASE
 #endif
 
+/* Vector versions sum blocks of 32 bytes. SSSE3 is checked for at run time,
+   NEON is part of every AArch64 processor. */
+#if (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || \
+     defined(_M_IX86)) && (defined(__GNUC__) || defined(_MSC_VER))
+#  define ADLER32_SSSE3
+#  include <emmintrin.h>
+#  include <tmmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#  define ADLER32_NEON
+#  include <arm_neon.h>
+#endif
+
+#if defined(ADLER32_SSSE3) || defined(ADLER32_NEON)
+
+#define SIMD_BLOCK 32
+#define SIMD_MIN 64     /* fewest bytes worth the vector setup */
+
+/* ===========================================================================
+ * Update the sums with the len / SIMD_BLOCK whole blocks at buf, returning
+ * the number of bytes consumed. Both sums stay reduced modulo BASE. The
+ * blocks of one iteration are a multiple of SIMD_BLOCK no larger than NMAX,
+ * so the accumulated sums cannot overflow 32 bits before the reduction.
+ */
+#ifdef ADLER32_SSSE3
+local Z_TARGET("ssse3") z_size_t adler32_simd(unsigned long *adler,
+        unsigned long *sum2, const Bytef *buf, z_size_t len) {
+    const __m128i tap1 = _mm_setr_epi8(32, 31, 30, 29, 28, 27, 26, 25,
+                                       24, 23, 22, 21, 20, 19, 18, 17);
+    const __m128i tap2 = _mm_setr_epi8(16, 15, 14, 13, 12, 11, 10, 9,
+                                       8, 7, 6, 5, 4, 3, 2, 1);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ones = _mm_set1_epi16(1);
+    z_size_t blocks = len / SIMD_BLOCK;
+    unsigned long s1 = *adler;
+    unsigned long s2 = *sum2;
+    unsigned n;
+    __m128i v_ps, v_s1, v_s2, bytes1, bytes2;
+
+    while (blocks) {
+        n = NMAX / SIMD_BLOCK;
+        if (n > blocks)
+            n = (unsigned)blocks;
+        blocks -= n;
+
+        /* v_ps accumulates s1 once per block, it is scaled by the block
+           size when the iteration is done. */
+        v_ps = _mm_set_epi32(0, 0, 0, (int)(s1 * n));
+        v_s2 = _mm_set_epi32(0, 0, 0, (int)s2);
+        v_s1 = _mm_setzero_si128();
+
+        do {
+            bytes1 = _mm_loadu_si128((const __m128i *)buf);
+            bytes2 = _mm_loadu_si128((const __m128i *)(buf + 16));
+
+            v_ps = _mm_add_epi32(v_ps, v_s1);
+
+            v_s1 = _mm_add_epi32(v_s1, _mm_sad_epu8(bytes1, zero));
+            v_s2 = _mm_add_epi32(v_s2,
+                _mm_madd_epi16(_mm_maddubs_epi16(bytes1, tap1), ones));
+            v_s1 = _mm_add_epi32(v_s1, _mm_sad_epu8(bytes2, zero));
+            v_s2 = _mm_add_epi32(v_s2,
+                _mm_madd_epi16(_mm_maddubs_epi16(bytes2, tap2), ones));
+
+            buf += SIMD_BLOCK;
+        } while (--n);
+
+        v_s2 = _mm_add_epi32(v_s2, _mm_slli_epi32(v_ps, 5));
+
+        /* Sum the lanes. The totals fit in 32 bits, so the wrapping lane
+           additions are exact. */
+        v_s1 = _mm_add_epi32(v_s1, _mm_shuffle_epi32(v_s1, 0x4e));
+        v_s1 = _mm_add_epi32(v_s1, _mm_shuffle_epi32(v_s1, 0xb1));
+        v_s2 = _mm_add_epi32(v_s2, _mm_shuffle_epi32(v_s2, 0x4e));
+        v_s2 = _mm_add_epi32(v_s2, _mm_shuffle_epi32(v_s2, 0xb1));
+
+        s1 += (unsigned)_mm_cvtsi128_si32(v_s1);
+        s2 = (unsigned)_mm_cvtsi128_si32(v_s2);
+        MOD(s1);
+        MOD(s2);
+    }
+
+    *adler = s1;
+    *sum2 = s2;
+    return len - len % SIMD_BLOCK;
+}
+#else /* ADLER32_NEON */
+local z_size_t adler32_simd(unsigned long *adler, unsigned long *sum2,
+                            const Bytef *buf, z_size_t len) {
+    static const uint16_t taps[SIMD_BLOCK] = {
+        32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17,
+        16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1
+    };
+    z_size_t blocks = len / SIMD_BLOCK;
+    unsigned long s1 = *adler;
+    unsigned long s2 = *sum2;
+    unsigned n;
+
+    while (blocks) {
+        uint32x4_t v_s1, v_s2;
+        uint16x8_t v_col1, v_col2, v_col3, v_col4;
+        uint32x2_t sum1, sum2v, s1s2;
+
+        n = NMAX / SIMD_BLOCK;
+        if (n > blocks)
+            n = (unsigned)blocks;
+        blocks -= n;
+
+        /* v_s2 accumulates s1 once per block, it is scaled by the block size
+           when the iteration is done. The per column byte sums are weighted
+           by their position afterwards. */
+        v_s2 = vsetq_lane_u32((uint32_t)(s1 * n), vdupq_n_u32(0), 3);
+        v_s1 = vdupq_n_u32(0);
+        v_col1 = vdupq_n_u16(0);
+        v_col2 = vdupq_n_u16(0);
+        v_col3 = vdupq_n_u16(0);
+        v_col4 = vdupq_n_u16(0);
+
+        do {
+            const uint8x16_t bytes1 = vld1q_u8(buf);
+            const uint8x16_t bytes2 = vld1q_u8(buf + 16);
+
+            v_s2 = vaddq_u32(v_s2, v_s1);
+            v_s1 = vpadalq_u16(v_s1, vpadalq_u8(vpaddlq_u8(bytes1), bytes2));
+
+            v_col1 = vaddw_u8(v_col1, vget_low_u8(bytes1));
+            v_col2 = vaddw_u8(v_col2, vget_high_u8(bytes1));
+            v_col3 = vaddw_u8(v_col3, vget_low_u8(bytes2));
+            v_col4 = vaddw_u8(v_col4, vget_high_u8(bytes2));
+
+            buf += SIMD_BLOCK;
+        } while (--n);
+
+        v_s2 = vshlq_n_u32(v_s2, 5);
+        v_s2 = vmlal_u16(v_s2, vget_low_u16(v_col1), vld1_u16(taps + 0));
+        v_s2 = vmlal_u16(v_s2, vget_high_u16(v_col1), vld1_u16(taps + 4));
+        v_s2 = vmlal_u16(v_s2, vget_low_u16(v_col2), vld1_u16(taps + 8));
+        v_s2 = vmlal_u16(v_s2, vget_high_u16(v_col2), vld1_u16(taps + 12));
+        v_s2 = vmlal_u16(v_s2, vget_low_u16(v_col3), vld1_u16(taps + 16));
+        v_s2 = vmlal_u16(v_s2, vget_high_u16(v_col3), vld1_u16(taps + 20));
+        v_s2 = vmlal_u16(v_s2, vget_low_u16(v_col4), vld1_u16(taps + 24));
+        v_s2 = vmlal_u16(v_s2, vget_high_u16(v_col4), vld1_u16(taps + 28));
+
+        /* Sum the lanes. The totals fit in 32 bits, so the wrapping lane
+           additions are exact. */
+        sum1 = vpadd_u32(vget_low_u32(v_s1), vget_high_u32(v_s1));
+        sum2v = vpadd_u32(vget_low_u32(v_s2), vget_high_u32(v_s2));
+        s1s2 = vpadd_u32(sum1, sum2v);
+
+        s1 += vget_lane_u32(s1s2, 0);
+        s2 += vget_lane_u32(s1s2, 1);
+        MOD(s1);
+        MOD(s2);
+    }
+
+    *adler = s1;
+    *sum2 = s2;
+    return len - len % SIMD_BLOCK;
+}
+#endif
+
+#endif /* ADLER32_SSSE3 || ADLER32_NEON */
+
 /* ========================================================================= */
 uLong ZEXPORT adler32_z(uLong adler, const Bytef *buf, z_size_t len) {
     unsigned long sum2;
@@ -93,6 +255,19 @@ uLong ZEXPORT adler32_z(uLong adler, const Bytef *buf, z_size_t len) {
         return adler | (sum2 << 16);
     }
 
+#if defined(ADLER32_SSSE3) || defined(ADLER32_NEON)
+    /* sum whole vector blocks, then let the scalar code do the remainder */
+#  ifdef ADLER32_SSSE3
+    if (len >= SIMD_MIN && (z_cpu_features() & Z_CPU_SSSE3)) {
+#  else
+    if (len >= SIMD_MIN) {
+#  endif
+        z_size_t done = adler32_simd(&adler, &sum2, buf, len);
+        buf += done;
+        len -= done;
+    }
+#endif
+
     /* do length NMAX blocks -- requires just one modulo operation */
     while (len >= NMAX) {
         len -= NMAX;
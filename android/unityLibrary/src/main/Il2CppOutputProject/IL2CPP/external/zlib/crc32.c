@@ -103,6 +103,19 @@
 #  define ARMCRC32
 #endif
 
+/* Otherwise check at run time for instructions that accelerate the CRC: carry-
+   less multiplication on x86, or the ARMv8 CRC32 instructions on AArch64. */
+#if !defined(ARMCRC32) && !defined(MAKECRCH)
+#  if (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || \
+       defined(_M_IX86)) && (defined(__GNUC__) || defined(_MSC_VER))
+#    define X86CRC32_CLMUL
+#  elif defined(__aarch64__) && W == 8 && \
+        (defined(__linux__) || defined(__APPLE__)) && \
+        (defined(__GNUC__) || defined(__clang__))
+#    define ARMCRC32_DISPATCH
+#  endif
+#endif
+
 #if defined(W) && (!defined(ARMCRC32) || defined(DYNAMIC_CRC_TABLE))
 /*
   Swap the bytes in a z_word_t to convert between little and big endian. Any
@@ -553,6 +566,205 @@ const z_crc_t FAR * ZEXPORT get_crc_table(void) {
     return (const z_crc_t FAR *)crc_table;
 }
 
+#ifdef X86CRC32_CLMUL
+
+#include <emmintrin.h>
+#include <smmintrin.h>
+#include <wmmintrin.h>
+
+#define Z_CLMUL_MIN 64      /* fewest bytes worth folding */
+
+/* =========================================================================
+ * Fold 16-byte blocks with carry-less multiplication, as described in "Fast
+ * CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction" by
+ * Gopal et al. (Intel, 2009). crc is the pre-conditioned CRC, len must be at
+ * least Z_CLMUL_MIN and a multiple of 16. The constants are x^k mod p(x) in
+ * the bit-reflected domain, followed by the Barrett reduction constants.
+ */
+local Z_TARGET("pclmul,sse4.1") z_crc_t crc32_clmul(z_crc_t crc,
+        const unsigned char FAR *buf, z_size_t len) {
+    const __m128i k1k2 = _mm_set_epi64x(0x01c6e41596, 0x0154442bd4);
+    const __m128i k3k4 = _mm_set_epi64x(0x00ccaa009e, 0x01751997d0);
+    const __m128i k5k0 = _mm_set_epi64x(0x0000000000, 0x0163cd6124);
+    const __m128i poly = _mm_set_epi64x(0x01f7011641, 0x01db710641);
+    const __m128i mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+    __m128i x0, x1, x2, x3, x4, x5, x6, x7, x8, y5, y6, y7, y8;
+
+    /* Load the first 64 bytes and fold the CRC into them. */
+    x1 = _mm_loadu_si128((const __m128i *)(buf + 0x00));
+    x2 = _mm_loadu_si128((const __m128i *)(buf + 0x10));
+    x3 = _mm_loadu_si128((const __m128i *)(buf + 0x20));
+    x4 = _mm_loadu_si128((const __m128i *)(buf + 0x30));
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int)crc));
+    buf += 64;
+    len -= 64;
+
+    /* Fold four blocks at a time in parallel. */
+    x0 = k1k2;
+    while (len >= 64) {
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+        x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+        x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+
+        y5 = _mm_loadu_si128((const __m128i *)(buf + 0x00));
+        y6 = _mm_loadu_si128((const __m128i *)(buf + 0x10));
+        y7 = _mm_loadu_si128((const __m128i *)(buf + 0x20));
+        y8 = _mm_loadu_si128((const __m128i *)(buf + 0x30));
+
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), y5);
+        x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), y6);
+        x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), y7);
+        x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), y8);
+
+        buf += 64;
+        len -= 64;
+    }
+
+    /* Fold the four blocks into one. */
+    x0 = k3k4;
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+    /* Fold in the remaining blocks one at a time. */
+    while (len >= 16) {
+        x2 = _mm_loadu_si128((const __m128i *)buf);
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+        buf += 16;
+        len -= 16;
+    }
+
+    /* Reduce 128 bits to 64 bits. */
+    x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+    x1 = _mm_srli_si128(x1, 8);
+    x1 = _mm_xor_si128(x1, x2);
+
+    x0 = k5k0;
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, mask32);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    /* Barrett reduce to 32 bits. */
+    x0 = poly;
+    x2 = _mm_and_si128(x1, mask32);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x10);
+    x2 = _mm_and_si128(x2, mask32);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    return (z_crc_t)_mm_extract_epi32(x1, 1);
+}
+
+#endif /* X86CRC32_CLMUL */
+
+#ifdef ARMCRC32_DISPATCH
+
+#if defined(__clang__)
+#  define Z_TARGET_CRC Z_TARGET("crc")
+#  define Z_CRC32B(crc, val) __builtin_arm_crc32b(crc, val)
+#  define Z_CRC32D(crc, val) __builtin_arm_crc32d(crc, val)
+#else
+#  define Z_TARGET_CRC Z_TARGET("+crc")
+#  define Z_CRC32B(crc, val) __builtin_aarch64_crc32b(crc, val)
+#  define Z_CRC32D(crc, val) __builtin_aarch64_crc32x(crc, val)
+#endif
+
+/* Same batching as the ARMCRC32 code below, see there. */
+#define Z_BATCH 3990                /* number of words in a batch */
+#define Z_BATCH_ZEROS 0xa10d3d0c    /* computed from Z_BATCH = 3990 */
+#define Z_BATCH_MIN 800             /* fewest words in a final batch */
+
+/* =========================================================================
+ * The ARMCRC32 algorithm for processors that turn out to have the CRC32
+ * instructions only at run time. crc is the pre-conditioned CRC.
+ */
+local Z_TARGET_CRC z_crc_t crc32_armv8(z_crc_t crc,
+        const unsigned char FAR *buf, z_size_t len) {
+    z_crc_t val;
+    z_crc_t crc1, crc2;
+    const z_word_t *word;
+    z_size_t last, last2, i;
+    z_size_t num;
+
+    /* Compute the CRC up to a word boundary. */
+    while (len && ((z_size_t)buf & 7) != 0) {
+        len--;
+        crc = Z_CRC32B(crc, *buf++);
+    }
+
+    /* Compute the CRC on full 64-bit words word[0..num-1]. */
+    word = (z_word_t const *)buf;
+    num = len >> 3;
+    len &= 7;
+
+    /* Three interleaved CRCs keep the crc32x pipeline full. */
+    while (num >= 3 * Z_BATCH) {
+        crc1 = 0;
+        crc2 = 0;
+        for (i = 0; i < Z_BATCH; i++) {
+            crc = Z_CRC32D(crc, word[i]);
+            crc1 = Z_CRC32D(crc1, word[i + Z_BATCH]);
+            crc2 = Z_CRC32D(crc2, word[i + 2 * Z_BATCH]);
+        }
+        word += 3 * Z_BATCH;
+        num -= 3 * Z_BATCH;
+        crc = multmodp(Z_BATCH_ZEROS, crc) ^ crc1;
+        crc = multmodp(Z_BATCH_ZEROS, crc) ^ crc2;
+    }
+
+    last = num / 3;
+    if (last >= Z_BATCH_MIN) {
+        last2 = last << 1;
+        crc1 = 0;
+        crc2 = 0;
+        for (i = 0; i < last; i++) {
+            crc = Z_CRC32D(crc, word[i]);
+            crc1 = Z_CRC32D(crc1, word[i + last]);
+            crc2 = Z_CRC32D(crc2, word[i + last2]);
+        }
+        word += 3 * last;
+        num -= 3 * last;
+        val = x2nmodp(last, 6);
+        crc = multmodp(val, crc) ^ crc1;
+        crc = multmodp(val, crc) ^ crc2;
+    }
+
+    for (i = 0; i < num; i++)
+        crc = Z_CRC32D(crc, word[i]);
+    word += num;
+
+    buf = (const unsigned char FAR *)word;
+    while (len) {
+        len--;
+        crc = Z_CRC32B(crc, *buf++);
+    }
+
+    return crc;
+}
+
+#undef Z_BATCH
+#undef Z_BATCH_ZEROS
+#undef Z_BATCH_MIN
+
+#endif /* ARMCRC32_DISPATCH */
+
 /* =========================================================================
  * Use ARM machine instructions if available. This will compute the CRC about
  * ten times faster than the braided calculation. This code does not check for
@@ -703,6 +915,20 @@ unsigned long ZEXPORT crc32_z(unsigned long crc, const unsigned char FAR *buf,
     /* Pre-condition the CRC */
     crc = (~crc) & 0xffffffff;
 
+#ifdef X86CRC32_CLMUL
+    if (len >= Z_CLMUL_MIN && (z_cpu_features() & Z_CPU_PCLMUL)) {
+        z_size_t blocks = len & ~(z_size_t)15;
+        crc = crc32_clmul((z_crc_t)crc, buf, blocks);
+        buf += blocks;
+        len -= blocks;
+    }
+#endif
+
+#ifdef ARMCRC32_DISPATCH
+    if (z_cpu_features() & Z_CPU_ARM_CRC32)
+        return crc32_armv8((z_crc_t)crc, buf, len) ^ 0xffffffff;
+#endif
+
 #ifdef W
 
     /* If provided enough bytes, do a braided CRC calculation. */
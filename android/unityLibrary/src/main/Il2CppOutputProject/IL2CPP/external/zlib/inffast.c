@@ -46,7 +46,49 @@
       bytes, which is the maximum length that can be coded.  inflate_fast()
       requires strm->avail_out >= 258 for each loop to avoid checking for
       output space.
+
+    - Matches copied from the output are copied INFLATE_CHUNK bytes at a time
+      when at least INFLATE_CHUNK - 1 bytes of output space remain past the
+      end of the match. Those extra bytes are overwritten with data that is
+      not reported as output, and is replaced by the next match or literal.
  */
+
+#define INFLATE_CHUNK 8
+
+/* Copy a match of len bytes that starts dist bytes back in the output, using
+   INFLATE_CHUNK byte copies. This can write up to INFLATE_CHUNK - 1 bytes past
+   out + len. Returns out + len. */
+local unsigned char FAR *chunk_copy(unsigned char FAR *out, unsigned dist,
+                                    unsigned len) {
+    unsigned char FAR *stop = out + len;
+    const unsigned char FAR *from = out - dist;
+    unsigned period, head;
+
+    /* A match closer than INFLATE_CHUNK repeats every dist bytes, so it also
+       repeats every multiple of dist. Write the bytes that are too close to
+       the start to copy from a multiple at least INFLATE_CHUNK back one at a
+       time, then continue from that multiple. */
+    if (dist < INFLATE_CHUNK) {
+        period = dist;
+        while (period < INFLATE_CHUNK)
+            period += dist;
+        head = period - dist;
+        if (head > len)
+            head = len;
+        while (head--)
+            *out++ = *from++;
+        from = out - period;
+    }
+
+    /* Every chunk reads only bytes that are already in place. */
+    while (out < stop) {
+        zmemcpy(out, from, INFLATE_CHUNK);
+        out += INFLATE_CHUNK;
+        from += INFLATE_CHUNK;
+    }
+    return stop;
+}
+
 void ZLIB_INTERNAL inflate_fast(z_streamp strm, unsigned start) {
     struct inflate_state FAR *state;
     z_const unsigned char FAR *in;      /* local strm->next_in */
@@ -54,6 +96,7 @@ void ZLIB_INTERNAL inflate_fast(z_streamp strm, unsigned start) {
     unsigned char FAR *out;     /* local strm->next_out */
     unsigned char FAR *beg;     /* inflate()'s initial strm->next_out */
     unsigned char FAR *end;     /* while out < end, enough space available */
+    unsigned char FAR *limit;   /* end of the output space */
 #ifdef INFLATE_STRICT
     unsigned dmax;              /* maximum distance from zlib header */
 #endif
@@ -81,6 +124,7 @@ void ZLIB_INTERNAL inflate_fast(z_streamp strm, unsigned start) {
     out = strm->next_out;
     beg = out - (start - strm->avail_out);
     end = out + (strm->avail_out - 257);
+    limit = out + strm->avail_out;
 #ifdef INFLATE_STRICT
     dmax = state->dmax;
 #endif
@@ -198,9 +242,9 @@ void ZLIB_INTERNAL inflate_fast(z_streamp strm, unsigned start) {
                         from += wsize - op;
                         if (op < len) {         /* some from window */
                             len -= op;
-                            do {
-                                *out++ = *from++;
-                            } while (--op);
+                            zmemcpy(out, from, op);
+                            out += op;
+                            from += op;
                             from = out - dist;  /* rest from output */
                         }
                     }
@@ -209,16 +253,16 @@ void ZLIB_INTERNAL inflate_fast(z_streamp strm, unsigned start) {
                         op -= wnext;
                         if (op < len) {         /* some from end of window */
                             len -= op;
-                            do {
-                                *out++ = *from++;
-                            } while (--op);
+                            zmemcpy(out, from, op);
+                            out += op;
+                            from += op;
                             from = window;
                             if (wnext < len) {  /* some from start of window */
                                 op = wnext;
                                 len -= op;
-                                do {
-                                    *out++ = *from++;
-                                } while (--op);
+                                zmemcpy(out, from, op);
+                                out += op;
+                                from += op;
                                 from = out - dist;      /* rest from output */
                             }
                         }
@@ -227,9 +271,9 @@ void ZLIB_INTERNAL inflate_fast(z_streamp strm, unsigned start) {
                         from += wnext - op;
                         if (op < len) {         /* some from window */
                             len -= op;
-                            do {
-                                *out++ = *from++;
-                            } while (--op);
+                            zmemcpy(out, from, op);
+                            out += op;
+                            from += op;
                             from = out - dist;  /* rest from output */
                         }
                     }
@@ -245,6 +289,9 @@ void ZLIB_INTERNAL inflate_fast(z_streamp strm, unsigned start) {
                             *out++ = *from++;
                     }
                 }
+                else if (len + INFLATE_CHUNK - 1 <= (unsigned)(limit - out)) {
+                    out = chunk_copy(out, dist, len);
+                }
                 else {
                     from = out - dist;          /* copy direct from output */
                     do {                        /* minimum length is three */
@@ -0,0 +1,189 @@
+/* check.c -- self check of the accelerated checksums and inflate_fast
+ * For conditions of distribution and use, see copyright notice in zlib.h
+ *
+ * Compares crc32() and adler32() against bitwise reference implementations
+ * over many lengths, alignments and split points, and round-trips data
+ * through deflate and inflate. Whatever checksum path z_cpu_features()
+ * selects on the machine running it is the one under test, so run it on
+ * each target architecture:
+ *
+ *   cc -O2 -I.. ../[a-z]*.c check.c -o check && ./check
+ */
+
+#include "zlib.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BUFFER_SIZE (1 << 20)
+
+static int failures = 0;
+
+static void fail(const char *what, unsigned long detail) {
+    fprintf(stderr, "FAIL: %s (%lu)\n", what, detail);
+    failures++;
+}
+
+static unsigned long reference_crc32(unsigned long crc, const unsigned char *buf,
+                                     size_t len) {
+    int k;
+
+    crc = ~crc & 0xffffffffUL;
+    while (len--) {
+        crc ^= *buf++;
+        for (k = 0; k < 8; k++)
+            crc = crc & 1 ? (crc >> 1) ^ 0xedb88320UL : crc >> 1;
+    }
+    return ~crc & 0xffffffffUL;
+}
+
+static unsigned long reference_adler32(unsigned long adler,
+                                       const unsigned char *buf, size_t len) {
+    unsigned long a = adler & 0xffff, b = (adler >> 16) & 0xffff;
+
+    while (len--) {
+        a = (a + *buf++) % 65521UL;
+        b = (b + a) % 65521UL;
+    }
+    return (b << 16) | a;
+}
+
+/* Deterministic filler, so failures reproduce */
+static void fill(unsigned char *buf, size_t len, unsigned seed, int runs) {
+    size_t i;
+
+    for (i = 0; i < len; i++) {
+        seed = seed * 1103515245U + 12345U;
+        /* Long repeats give deflate matches for inflate_fast to copy */
+        buf[i] = runs && (seed >> 28) < 12 && i >= 300 ?
+                 buf[i - 1 - (seed >> 16) % 300] : (unsigned char)(seed >> 16);
+    }
+}
+
+static void check_checksums(const unsigned char *buf) {
+    size_t len, offset, split;
+    unsigned long crc, adler;
+
+    /* Every length up to a few vector blocks, at every alignment */
+    for (offset = 0; offset < 16; offset++) {
+        for (len = 0; len <= 1024; len++) {
+            if (crc32(0, buf + offset, (uInt)len) !=
+                reference_crc32(0, buf + offset, len))
+                fail("crc32 length", (unsigned long)(offset << 16 | len));
+            if (adler32(1, buf + offset, (uInt)len) !=
+                reference_adler32(1, buf + offset, len))
+                fail("adler32 length", (unsigned long)(offset << 16 | len));
+        }
+    }
+
+    /* Large buffers, past the adler32 NMAX and the crc32 folding thresholds */
+    for (len = 4096; len <= BUFFER_SIZE - 16; len = len * 3 + 7) {
+        if (crc32(0, buf + 3, (uInt)len) != reference_crc32(0, buf + 3, len))
+            fail("crc32 large", (unsigned long)len);
+        if (adler32(1, buf + 3, (uInt)len) !=
+            reference_adler32(1, buf + 3, len))
+            fail("adler32 large", (unsigned long)len);
+    }
+
+    /* Incremental updates must continue from any intermediate value */
+    len = 70000;
+    for (split = 0; split <= len; split += 997) {
+        crc = crc32(crc32(0, buf, (uInt)split), buf + split, (uInt)(len - split));
+        if (crc != reference_crc32(0, buf, len))
+            fail("crc32 split", (unsigned long)split);
+        adler = adler32(adler32(1, buf, (uInt)split), buf + split,
+                        (uInt)(len - split));
+        if (adler != reference_adler32(1, buf, len))
+            fail("adler32 split", (unsigned long)split);
+    }
+}
+
+static void check_round_trip(const unsigned char *input, size_t len, int level,
+                             int windowBits, uInt outChunk) {
+    z_stream strm;
+    uLong bound;
+    unsigned char *compressed, *output;
+    size_t compressedLen, produced;
+    int ret;
+
+    memset(&strm, 0, sizeof(strm));
+    if (deflateInit2(&strm, level, Z_DEFLATED, windowBits, 8,
+                     Z_DEFAULT_STRATEGY) != Z_OK) {
+        fail("deflateInit2", (unsigned long)level);
+        return;
+    }
+    bound = deflateBound(&strm, (uLong)len);
+    compressed = (unsigned char *)malloc(bound);
+    output = (unsigned char *)malloc(len + 1);
+    strm.next_in = (z_const Bytef *)input;
+    strm.avail_in = (uInt)len;
+    strm.next_out = compressed;
+    strm.avail_out = (uInt)bound;
+    ret = deflate(&strm, Z_FINISH);
+    compressedLen = strm.total_out;
+    deflateEnd(&strm);
+    if (ret != Z_STREAM_END) {
+        fail("deflate", (unsigned long)level);
+        goto done;
+    }
+
+    /* Small output chunks make inflate leave and re-enter inflate_fast at
+       every possible distance from the end of the window */
+    memset(&strm, 0, sizeof(strm));
+    if (inflateInit2(&strm, windowBits) != Z_OK) {
+        fail("inflateInit2", (unsigned long)level);
+        goto done;
+    }
+    strm.next_in = compressed;
+    strm.avail_in = (uInt)compressedLen;
+    produced = 0;
+    do {
+        uInt chunk = (uInt)(len + 1 - produced) < outChunk ?
+                     (uInt)(len + 1 - produced) : outChunk;
+        strm.next_out = output + produced;
+        strm.avail_out = chunk;
+        ret = inflate(&strm, Z_NO_FLUSH);
+        produced += chunk - strm.avail_out;
+    } while (ret == Z_OK && produced <= len);
+    inflateEnd(&strm);
+
+    if (ret != Z_STREAM_END || produced != len ||
+        memcmp(input, output, len) != 0)
+        fail("inflate round trip", (unsigned long)(level << 24 | outChunk));
+
+done:
+    free(compressed);
+    free(output);
+}
+
+int main(void) {
+    unsigned char *random, *runs;
+    static const uInt chunks[] = { 1, 7, 258, 4096, 1 << 20 };
+    static const int windows[] = { 15, 15 + 16, 9 };
+    int level;
+    size_t c, w;
+
+    random = (unsigned char *)malloc(BUFFER_SIZE);
+    runs = (unsigned char *)malloc(BUFFER_SIZE);
+    fill(random, BUFFER_SIZE, 1, 0);
+    fill(runs, BUFFER_SIZE, 2, 1);
+
+    check_checksums(random);
+
+    for (level = 0; level <= 9; level++)
+        for (w = 0; w < sizeof(windows) / sizeof(windows[0]); w++)
+            for (c = 0; c < sizeof(chunks) / sizeof(chunks[0]); c++)
+                check_round_trip(runs, 300000, level, windows[w], chunks[c]);
+    for (w = 0; w < sizeof(windows) / sizeof(windows[0]); w++)
+        check_round_trip(random, 100000, 6, windows[w], 4096);
+
+    free(random);
+    free(runs);
+
+    if (failures != 0) {
+        fprintf(stderr, "%d checks failed\n", failures);
+        return 1;
+    }
+    printf("zlib %s: all checks passed\n", zlibVersion());
+    return 0;
+}
@@ -10,6 +10,48 @@
 #  include "gzguts.h"
 #endif
 
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#  define Z_CPU_X86
+#  if defined(_MSC_VER) && !defined(__clang__)
+#    include <intrin.h>
+#  else
+#    include <cpuid.h>
+#  endif
+#elif defined(__aarch64__) && defined(__linux__)
+#  define Z_CPU_ARM64_LINUX
+#  include <sys/auxv.h>
+#  ifndef HWCAP_CRC32
+#    define HWCAP_CRC32 (1 << 7)
+#  endif
+#elif defined(__aarch64__) && defined(__APPLE__)
+#  define Z_CPU_ARM64_APPLE
+#  include <sys/types.h>
+#  include <sys/sysctl.h>
+#endif
+
+/* Relaxed atomic access to the cached processor features, which threads may
+   compute concurrently on their first checksum. */
+#if defined(__STDC__) && __STDC_VERSION__ >= 201112L && \
+    !defined(__STDC_NO_ATOMICS__)
+#  include <stdatomic.h>
+#  define Z_FEATURES_TYPE atomic_int
+#  define Z_FEATURES_LOAD(p) atomic_load_explicit(p, memory_order_relaxed)
+#  define Z_FEATURES_STORE(p, v) atomic_store_explicit(p, v, memory_order_relaxed)
+#elif defined(__GNUC__) || defined(__clang__)
+#  define Z_FEATURES_TYPE int
+#  define Z_FEATURES_LOAD(p) __atomic_load_n(p, __ATOMIC_RELAXED)
+#  define Z_FEATURES_STORE(p, v) __atomic_store_n(p, v, __ATOMIC_RELAXED)
+#elif defined(_MSC_VER)
+#  include <intrin.h>
+#  define Z_FEATURES_TYPE int
+#  define Z_FEATURES_LOAD(p) __iso_volatile_load32(p)
+#  define Z_FEATURES_STORE(p, v) __iso_volatile_store32(p, v)
+#else
+#  define Z_FEATURES_TYPE int
+#  define Z_FEATURES_LOAD(p) (*(p))
+#  define Z_FEATURES_STORE(p, v) (*(p) = (v))
+#endif
+
 z_const char * const z_errmsg[10] = {
     (z_const char *)"need dictionary",     /* Z_NEED_DICT       2  */
     (z_const char *)"stream end",          /* Z_STREAM_END      1  */
@@ -24,6 +66,49 @@ z_const char * const z_errmsg[10] = {
 };
 
 
+local Z_FEATURES_TYPE cpu_features = -1;
+
+local int detect_cpu_features(void) {
+    int features = 0;
+#if defined(Z_CPU_X86)
+    unsigned ecx;
+#  if defined(_MSC_VER) && !defined(__clang__)
+    int regs[4];
+    __cpuid(regs, 1);
+    ecx = (unsigned)regs[2];
+#  else
+    unsigned eax, ebx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+        return 0;
+#  endif
+    if (ecx & (1U << 9))
+        features |= Z_CPU_SSSE3;
+    if ((ecx & (1U << 1)) && (ecx & (1U << 19)))
+        features |= Z_CPU_PCLMUL;
+#elif defined(Z_CPU_ARM64_LINUX)
+    if (getauxval(AT_HWCAP) & HWCAP_CRC32)
+        features |= Z_CPU_ARM_CRC32;
+#elif defined(Z_CPU_ARM64_APPLE)
+    int value = 0;
+    size_t size = sizeof(value);
+    if (sysctlbyname("hw.optional.armv8_crc32", &value, &size, NULL, 0) == 0 &&
+        value)
+        features |= Z_CPU_ARM_CRC32;
+#endif
+    return features;
+}
+
+/* Threads racing on the first call all store the same value, so relaxed
+   ordering is enough. */
+int ZLIB_INTERNAL z_cpu_features(void) {
+    int features = Z_FEATURES_LOAD(&cpu_features);
+    if (features < 0) {
+        features = detect_cpu_features();
+        Z_FEATURES_STORE(&cpu_features, features);
+    }
+    return features;
+}
+
 const char * ZEXPORT zlibVersion(void) {
     return ZLIB_VERSION;
 }
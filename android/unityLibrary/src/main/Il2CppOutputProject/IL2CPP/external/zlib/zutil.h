@@ -55,6 +55,7 @@ typedef unsigned long  ulg;
 
 #if Z_PREFIX
     #define z_errmsg il2cpp_z_errmsg
+    #define z_cpu_features il2cpp_z_cpu_features
 #endif
 
 extern z_const char * const z_errmsg[10]; /* indexed by 2-zlib_error */
@@ -255,4 +256,20 @@ extern z_const char * const z_errmsg[10]; /* indexed by 2-zlib_error */
 #define ZSWAP32(q) ((((q) >> 24) & 0xff) + (((q) >> 8) & 0xff00) + \
                     (((q) & 0xff00) << 8) + (((q) & 0xff) << 24))
 
+/* Processor features detected at run time, used to select accelerated
+   checksum implementations. Z_CPU_PCLMUL implies SSE4.1 as well. */
+#define Z_CPU_SSSE3     0x1
+#define Z_CPU_PCLMUL    0x2
+#define Z_CPU_ARM_CRC32 0x4
+
+int ZLIB_INTERNAL z_cpu_features(void);
+
+/* Function attribute enabling an instruction set extension for the code of
+   one function only, so the rest of the library keeps the baseline target. */
+#if defined(__GNUC__) || defined(__clang__)
+#  define Z_TARGET(features) __attribute__((target(features)))
+#else
+#  define Z_TARGET(features)
+#endif
+
 #endif /* ZUTIL_H */
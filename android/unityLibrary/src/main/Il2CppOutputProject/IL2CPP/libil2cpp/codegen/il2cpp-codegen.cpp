@@ -834,6 +834,11 @@ char* il2cpp_codegen_marshal_string(String_t* string)
     return il2cpp::vm::PlatformInvoke::MarshalCSharpStringToCppString((RuntimeString*)string);
 }
 
+char* il2cpp_codegen_marshal_string_buffered(String_t* string, char* buffer, size_t bufferSize)
+{
+    return il2cpp::vm::PlatformInvoke::MarshalCSharpStringToCppStringBuffered((RuntimeString*)string, buffer, bufferSize);
+}
+
 void il2cpp_codegen_marshal_string_fixed(String_t* string, char* buffer, int numberOfCharacters)
 {
     return il2cpp::vm::PlatformInvoke::MarshalCSharpStringToCppStringFixed((RuntimeString*)string, buffer, numberOfCharacters);
@@ -909,6 +914,11 @@ void il2cpp_codegen_marshal_free(void* ptr)
     il2cpp::vm::PlatformInvoke::MarshalFree(ptr);
 }
 
+void il2cpp_codegen_marshal_free_buffered(void* ptr, void* buffer)
+{
+    il2cpp::vm::PlatformInvoke::MarshalFreeBuffered(ptr, buffer);
+}
+
 Il2CppMethodPointer il2cpp_codegen_marshal_delegate(MulticastDelegate_t* d)
 {
     return (Il2CppMethodPointer)il2cpp::vm::PlatformInvoke::MarshalDelegate((RuntimeDelegate*)d);
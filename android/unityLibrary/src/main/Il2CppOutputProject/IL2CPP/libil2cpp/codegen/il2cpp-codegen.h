@@ -853,6 +853,10 @@ inline T* il2cpp_codegen_marshal_allocate()
 
 char* il2cpp_codegen_marshal_string(String_t* string);
 
+// Marshals into a caller provided (typically stack) buffer when the string fits.
+// The result must be released with il2cpp_codegen_marshal_free_buffered.
+char* il2cpp_codegen_marshal_string_buffered(String_t* string, char* buffer, size_t bufferSize);
+
 void il2cpp_codegen_marshal_string_fixed(String_t* string, char* buffer, int numberOfCharacters);
 
 Il2CppChar* il2cpp_codegen_marshal_wstring(String_t* string);
@@ -904,6 +908,8 @@ void il2cpp_codegen_delete_native_type(Il2CppWindowsRuntimeTypeName& nativeType)
 
 void il2cpp_codegen_marshal_free(void* ptr);
 
+void il2cpp_codegen_marshal_free_buffered(void* ptr, void* buffer);
+
 Il2CppMethodPointer il2cpp_codegen_marshal_delegate(MulticastDelegate_t* d);
 
 Il2CppDelegate* il2cpp_codegen_marshal_function_ptr_to_delegate_internal(void* functionPtr, Il2CppClass* delegateType);
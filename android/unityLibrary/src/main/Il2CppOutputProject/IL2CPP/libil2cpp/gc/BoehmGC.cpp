@@ -683,8 +683,9 @@ clear_ephemerons(void)
             if (!current_ephemeron->key || current_ephemeron->key == tombstone)
                 continue;
 
-            /* If the key is not marked, then set it to the tombstone and the value to NULL. */
-            if (!GC_is_marked(current_ephemeron->key))
+            /* If the key is not marked, then set it to the tombstone and the value to NULL.
+             * Keys outside of the GC heap (frozen strings) are never collected. */
+            if (GC_is_heap_ptr(current_ephemeron->key) && !GC_is_marked(current_ephemeron->key))
             {
                 il2cpp::gc::WriteBarrier::GenericStore(&current_ephemeron->key, tombstone);
                 current_ephemeron->value = NULL;
@@ -726,7 +727,7 @@ push_ephemerons(GC_ms_entry* mark_stack_ptr, GC_ms_entry* mark_stack_limit)
                 continue;
 
             /* If the key is not marked, then don't mark value. */
-            if (!GC_is_marked(current_ephemeron->key))
+            if (GC_is_heap_ptr(current_ephemeron->key) && !GC_is_marked(current_ephemeron->key))
                 continue;
 
             if (current_ephemeron->value)
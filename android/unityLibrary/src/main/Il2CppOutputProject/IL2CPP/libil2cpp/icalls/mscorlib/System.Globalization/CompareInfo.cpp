@@ -7,11 +7,16 @@
 #include "vm/String.h"
 #include "vm/Exception.h"
 #include "vm/Array.h"
+#include "utils/Simd.h"
 #include "utils/StringUtils.h"
 #include "vm-utils/VmStringUtils.h"
 #include <cwctype>
 #include <wctype.h>
 #include <algorithm>
+#include <string.h>
+
+#include "Baselib.h"
+#include "Cpp/Algorithm.h"
 
 namespace il2cpp
 {
@@ -54,66 +59,259 @@ namespace Globalization
         return ((result < 0) ? -1 : (result > 0) ? 1 : 0);
     }
 
-    int32_t CompareInfo::internal_compare_icall(Il2CppChar* str1, int32_t length1, Il2CppChar* str2, int32_t length2, int32_t options)
+    // Case folding that only touches 'A'-'Z' gives the same answer as towlower for ASCII in every locale
+    // we know of, but towlower is locale dependent, so this is checked once rather than assumed.
+    static bool AsciiFoldingMatchesTowlower()
     {
-        // Do a normal ascii string compare, as we only know the invariant locale if we dont have ICU.
-        /* c translation of C# code from old string.cs.. :) */
-        const int length = std::max(length1, length2);
-        int charcmp;
-        int pos = 0;
+        for (Il2CppChar c = 0; c < 0x80; c++)
+        {
+            Il2CppChar folded = (c >= 'A' && c <= 'Z') ? (Il2CppChar)(c | 0x20) : c;
+            if ((Il2CppChar)towlower(c) != folded)
+                return false;
+        }
+        return true;
+    }
+
+#if IL2CPP_SIMD_SSE2 || IL2CPP_SIMD_NEON
+    // Each helper below works on 8 UTF-16 code units and returns lane masks with one bit per code unit
+#if IL2CPP_SIMD_SSE2
+    typedef __m128i CharVector;
+
+    static inline CharVector LoadChars(const Il2CppChar* chars)
+    {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(chars));
+    }
+
+    static inline CharVector BroadcastChar(Il2CppChar c)
+    {
+        return _mm_set1_epi16((short)c);
+    }
+
+    static inline uint32_t EqualLanes(CharVector left, CharVector right)
+    {
+        return (uint32_t)_mm_movemask_epi8(_mm_packs_epi16(_mm_cmpeq_epi16(left, right), _mm_setzero_si128()));
+    }
+
+    static inline uint32_t EqualLanes(CharVector left1, CharVector right1, CharVector left2, CharVector right2)
+    {
+        __m128i equal = _mm_and_si128(_mm_cmpeq_epi16(left1, right1), _mm_cmpeq_epi16(left2, right2));
+        return (uint32_t)_mm_movemask_epi8(_mm_packs_epi16(equal, _mm_setzero_si128()));
+    }
+
+    static inline CharVector FoldAsciiCase(CharVector chars)
+    {
+        // SSE2 only has signed 16 bit compares, biasing by 0x8000 turns c - 'A' < 26 into one
+        __m128i biased = _mm_add_epi16(chars, _mm_set1_epi16((short)(0x8000 - 'A')));
+        __m128i upper = _mm_cmplt_epi16(biased, _mm_set1_epi16((short)(26 - 0x8000)));
+        return _mm_or_si128(chars, _mm_and_si128(upper, _mm_set1_epi16(0x20)));
+    }
 
-        for (pos = 0; pos != length; pos++)
+#else
+    typedef uint16x8_t CharVector;
+
+    static inline CharVector LoadChars(const Il2CppChar* chars)
+    {
+        return vld1q_u16(reinterpret_cast<const uint16_t*>(chars));
+    }
+
+    static inline CharVector BroadcastChar(Il2CppChar c)
+    {
+        return vdupq_n_u16(c);
+    }
+
+    static inline uint32_t LaneMask(uint16x8_t lanes)
+    {
+        static const uint8_t kLaneBits[8] = { 1, 2, 4, 8, 16, 32, 64, 128 };
+        return vaddv_u8(vand_u8(vmovn_u16(lanes), vld1_u8(kLaneBits)));
+    }
+
+    static inline uint32_t EqualLanes(CharVector left, CharVector right)
+    {
+        return LaneMask(vceqq_u16(left, right));
+    }
+
+    static inline uint32_t EqualLanes(CharVector left1, CharVector right1, CharVector left2, CharVector right2)
+    {
+        return LaneMask(vandq_u16(vceqq_u16(left1, right1), vceqq_u16(left2, right2)));
+    }
+
+    static inline CharVector FoldAsciiCase(CharVector chars)
+    {
+        uint16x8_t upper = vcltq_u16(vsubq_u16(chars, vdupq_n_u16('A')), vdupq_n_u16(26));
+        return vorrq_u16(chars, vandq_u16(upper, vdupq_n_u16(0x20)));
+    }
+
+#endif
+    static const int32_t kCharsPerVector = 8;
+    static const uint32_t kAllLanes = 0xFF;
+#endif
+
+    // Number of leading code units that are identical in both strings
+    static int32_t MatchingPrefixLength(const Il2CppChar* str1, const Il2CppChar* str2, int32_t length)
+    {
+        int32_t pos = 0;
+
+#if IL2CPP_SIMD_SSE2 || IL2CPP_SIMD_NEON
+        for (; pos + kCharsPerVector <= length; pos += kCharsPerVector)
         {
-            if (pos >= length1 || pos >= length2)
+            uint32_t equal = EqualLanes(LoadChars(str1 + pos), LoadChars(str2 + pos));
+            if (equal != kAllLanes)
+                return pos + baselib::Algorithm::LowestBitNonZero(~equal & kAllLanes);
+        }
+#endif
+
+        while (pos < length && str1[pos] == str2[pos])
+            pos++;
+
+        return pos;
+    }
+
+    // Number of leading code units that are identical in both strings once ASCII letters are lower cased.
+    // Only valid when AsciiFoldingMatchesTowlower, anything else is left to the caller.
+    static int32_t MatchingPrefixLengthIgnoreAsciiCase(const Il2CppChar* str1, const Il2CppChar* str2, int32_t length)
+    {
+        int32_t pos = 0;
+
+#if IL2CPP_SIMD_SSE2 || IL2CPP_SIMD_NEON
+        for (; pos + kCharsPerVector <= length; pos += kCharsPerVector)
+        {
+            uint32_t equal = EqualLanes(FoldAsciiCase(LoadChars(str1 + pos)), FoldAsciiCase(LoadChars(str2 + pos)));
+            if (equal != kAllLanes)
+                return pos + baselib::Algorithm::LowestBitNonZero(~equal & kAllLanes);
+        }
+#endif
+
+        for (; pos < length; pos++)
+        {
+            Il2CppChar c1 = str1[pos];
+            Il2CppChar c2 = str2[pos];
+            if (c1 >= 'A' && c1 <= 'Z')
+                c1 |= 0x20;
+            if (c2 >= 'A' && c2 <= 'Z')
+                c2 |= 0x20;
+            if (c1 != c2)
                 break;
+        }
 
-            charcmp = string_invariant_compare_char(str1[pos], str2[pos],
-                options);
-            if (charcmp != 0)
-                return (charcmp);
+        return pos;
+    }
+
+    // Searches for value at the offsets [0, positions) of text, returning the lowest match or -1.
+    // Candidates are offsets whose first and last code units both match, 8 offsets are tested at once.
+    static int32_t FindFirst(const Il2CppChar* text, int32_t positions, const Il2CppChar* value, int32_t valueLength)
+    {
+        int32_t pos = 0;
+
+        if (valueLength == 0)
+            return positions > 0 ? 0 : -1;
+
+#if IL2CPP_SIMD_SSE2 || IL2CPP_SIMD_NEON
+        const CharVector first = BroadcastChar(value[0]);
+        const CharVector last = BroadcastChar(value[valueLength - 1]);
+        for (; pos + kCharsPerVector <= positions; pos += kCharsPerVector)
+        {
+            uint32_t candidates = EqualLanes(LoadChars(text + pos), first, LoadChars(text + pos + valueLength - 1), last);
+            while (candidates != 0)
+            {
+                int32_t candidate = pos + baselib::Algorithm::LowestBitNonZero(candidates);
+                if (memcmp(text + candidate, value, valueLength * sizeof(Il2CppChar)) == 0)
+                    return candidate;
+                candidates &= candidates - 1;
+            }
         }
+#endif
 
-        /* the lesser wins, so if we have looped until length we just
-         * need to check the last char
-         */
-        if (pos == length)
-            return (string_invariant_compare_char(str1[pos - 1], str2[pos - 1], options));
+        for (; pos < positions; pos++)
+        {
+            if (text[pos] == value[0] && memcmp(text + pos, value, valueLength * sizeof(Il2CppChar)) == 0)
+                return pos;
+        }
 
-        /* Test if one of the strings has been compared to the end */
-        if (pos >= length1)
+        return -1;
+    }
+
+    // Like FindFirst, but returns the highest match
+    static int32_t FindLast(const Il2CppChar* text, int32_t positions, const Il2CppChar* value, int32_t valueLength)
+    {
+        int32_t pos = positions;
+
+        if (valueLength == 0)
+            return positions - 1;
+
+#if IL2CPP_SIMD_SSE2 || IL2CPP_SIMD_NEON
+        const CharVector first = BroadcastChar(value[0]);
+        const CharVector last = BroadcastChar(value[valueLength - 1]);
+        for (; pos >= kCharsPerVector; pos -= kCharsPerVector)
+        {
+            int32_t block = pos - kCharsPerVector;
+            uint32_t candidates = EqualLanes(LoadChars(text + block), first, LoadChars(text + block + valueLength - 1), last);
+            while (candidates != 0)
+            {
+                int32_t bit = baselib::Algorithm::HighestBitNonZero(candidates);
+                if (memcmp(text + block + bit, value, valueLength * sizeof(Il2CppChar)) == 0)
+                    return block + bit;
+                candidates &= ~(1u << bit);
+            }
+        }
+#endif
+
+        while (--pos >= 0)
+        {
+            if (text[pos] == value[0] && memcmp(text + pos, value, valueLength * sizeof(Il2CppChar)) == 0)
+                return pos;
+        }
+
+        return -1;
+    }
+
+    int32_t CompareInfo::internal_compare_icall(Il2CppChar* str1, int32_t length1, Il2CppChar* str2, int32_t length2, int32_t options)
+    {
+        // Do a normal ascii string compare, as we only know the invariant locale if we dont have ICU.
+        static const bool asciiFoldingMatchesTowlower = AsciiFoldingMatchesTowlower();
+        const int32_t length = std::min(length1, length2);
+        int charcmp;
+        int32_t pos;
+
+        // Identical code units compare equal under every option, so the common prefix is skipped in bulk
+        // and only the first difference goes through string_invariant_compare_char
+        if ((options & CompareOptions_IgnoreCase) && !(options & CompareOptions_Ordinal) && asciiFoldingMatchesTowlower)
+            pos = MatchingPrefixLengthIgnoreAsciiCase(str1, str2, length);
+        else
+            pos = MatchingPrefixLength(str1, str2, length);
+
+        for (; pos < length; pos++)
         {
-            if (pos >= length2)
-                return (0);
-            return (-1);
+            charcmp = string_invariant_compare_char(str1[pos], str2[pos], options);
+            if (charcmp != 0)
+                return charcmp;
         }
-        else if (pos >= length2)
-            return (1);
 
-        /* if not, check our last char only.. (can this happen?) */
-        return (string_invariant_compare_char(str1[pos], str2[pos], options));
+        /* the lesser wins */
+        if (length1 == length2)
+            return 0;
+
+        return length1 < length2 ? -1 : 1;
     }
 
     int32_t CompareInfo::internal_index_icall(Il2CppChar* source, int32_t sindex, int32_t count, Il2CppChar* value, int32_t value_length, bool first)
     {
-        int pos, i;
+        // Both directions test count - value_length + 1 offsets, forwards from sindex or backwards so that
+        // the match ends at or before sindex
+        const int32_t positions = count - value_length + 1;
+        int32_t pos;
+
+        if (positions <= 0)
+            return -1;
 
         if (first)
         {
-            count -= value_length;
-            for (pos = sindex; pos <= sindex + count; pos++)
-                for (i = 0; source[pos + i] == value[i];)
-                    if (++i == value_length)
-                        return (pos);
-
-            return (-1);
+            pos = FindFirst(source + sindex, positions, value, value_length);
+            return pos < 0 ? -1 : sindex + pos;
         }
         else
         {
-            for (pos = sindex - value_length + 1; pos > sindex - count; pos--)
-                if (memcmp(source + pos, value, value_length * sizeof(Il2CppChar)) == 0)
-                    return (pos);
-
-            return (-1);
+            pos = FindLast(source + sindex - count + 1, positions, value, value_length);
+            return pos < 0 ? -1 : sindex - count + 1 + pos;
         }
     }
 } /* namespace Globalization */
@@ -136,7 +136,7 @@ namespace Threading
             return false;
         }
 
-        thisPtr->GetInternalThread()->state &= ~vm::kThreadStateUnstarted;
+        il2cpp::vm::Thread::ClrState(thisPtr->GetInternalThread(), vm::kThreadStateUnstarted);
         thisPtr->GetInternalThread()->tid = thread->Id();
         if (!thisPtr->GetInternalThread()->managed_id)
             thisPtr->GetInternalThread()->managed_id = il2cpp::vm::Thread::GetNewManagedId();
@@ -265,8 +265,7 @@ namespace Threading
         if (thread->longlived == NULL)
             return vm::kThreadStateStopped;
 
-        il2cpp::os::FastAutoLock lock(thread->longlived->synch_cs);
-        return (il2cpp::vm::ThreadState)thread->state;
+        return il2cpp::vm::Thread::GetState(thread);
     }
 
     void Thread::Abort_internal(Il2CppInternalThread* thread, Il2CppObject* stateInfo)
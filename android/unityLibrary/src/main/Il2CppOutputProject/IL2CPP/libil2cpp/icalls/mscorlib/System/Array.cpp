@@ -5,6 +5,7 @@
 #include "gc/GarbageCollector.h"
 #include "icalls/mscorlib/System/Array.h"
 #include "utils/Exception.h"
+#include "utils/MemoryCopy.h"
 #include "vm/Array.h"
 #include "vm/Class.h"
 #include "vm/Exception.h"
@@ -81,6 +82,30 @@ namespace System
         return (Il2CppArray*)il2cpp::vm::Array::NewFull(arrayType, arraySizeLengths, arraySizeBounds);
     }
 
+    // Checks that every non-null element in the range is an instance of klass. Arrays tend to hold objects
+    // of only a few classes, so the class of the last element that passed is remembered and IsInst only
+    // runs again when the class changes. COM objects are always checked, they can answer differently
+    // per instance.
+    static bool ElementsAreInstancesOf(Il2CppArray* source, int32_t source_idx, int32_t length, Il2CppClass* klass)
+    {
+        Il2CppClass* lastPassed = NULL;
+
+        for (int32_t i = source_idx; i < source_idx + length; ++i)
+        {
+            Il2CppObject *elem = il2cpp_array_get(source, Il2CppObject*, i);
+            if (elem == NULL || elem->klass == lastPassed)
+                continue;
+
+            if (!vm::Object::IsInst(elem, klass))
+                return false;
+
+            if (!elem->klass->is_import_or_windows_runtime)
+                lastPassed = elem->klass;
+        }
+
+        return true;
+    }
+
     bool Array::FastCopy(Il2CppArray* source, int32_t source_idx, Il2CppArray* dest, int32_t dest_idx, int32_t length)
     {
         int element_size;
@@ -108,12 +133,8 @@ namespace System
         // object[] -> valuetype[]
         if (src_class == il2cpp_defaults.object_class && dest_class->byval_arg.valuetype)
         {
-            for (i = source_idx; i < source_idx + length; ++i)
-            {
-                Il2CppObject *elem = il2cpp_array_get(source, Il2CppObject*, i);
-                if (elem && !vm::Object::IsInst(elem, dest_class))
-                    return false;
-            }
+            if (!ElementsAreInstancesOf(source, source_idx, length, dest_class))
+                return false;
 
             element_size = il2cpp_array_element_size(dest->klass);
             void *baseAddr = il2cpp_array_addr_with_size(dest, element_size, dest_idx);
@@ -128,7 +149,7 @@ namespace System
                 if (!elem)
                     vm::Exception::Raise(vm::Exception::GetInvalidCastException("At least one element in the source array could not be cast down to the destination array type."));
 
-                memcpy(il2cpp_array_addr_with_size(dest, element_size, dest_idx + (size_t)i), vm::Object::Unbox(elem), element_size);
+                utils::MemoryCopy::Move(il2cpp_array_addr_with_size(dest, element_size, dest_idx + (size_t)i), vm::Object::Unbox(elem), element_size);
             }
             gc::GarbageCollector::SetWriteBarrier((void**)baseAddr, byte_len);
 
@@ -143,12 +164,8 @@ namespace System
             // object[] -> reftype[]
             if (vm::Class::IsSubclassOf(dest_class, src_class, false))
             {
-                for (i = source_idx; i < source_idx + length; ++i)
-                {
-                    Il2CppObject *elem = il2cpp_array_get(source, Il2CppObject*, i);
-                    if (elem && !vm::Object::IsInst(elem, dest_class))
-                        vm::Exception::Raise(vm::Exception::GetInvalidCastException("At least one element in the source array could not be cast down to the destination array type."));
-                }
+                if (!ElementsAreInstancesOf(source, source_idx, length, dest_class))
+                    vm::Exception::Raise(vm::Exception::GetInvalidCastException("At least one element in the source array could not be cast down to the destination array type."));
             }
             else if (!vm::Class::IsSubclassOf(src_class, dest_class, false))
                 return false;
@@ -164,12 +181,12 @@ namespace System
 
         size_t byte_len = (size_t)length * element_size;
 
-        memmove(
-            il2cpp_array_addr_with_size(dest, element_size, dest_idx),
-            il2cpp_array_addr_with_size(source, element_size, source_idx),
-            byte_len);
+        void* destAddr = il2cpp_array_addr_with_size(dest, element_size, dest_idx);
+        utils::MemoryCopy::Move(destAddr, il2cpp_array_addr_with_size(source, element_size, source_idx), byte_len);
 
-        gc::GarbageCollector::SetWriteBarrier((void**)il2cpp_array_addr_with_size(dest, element_size, dest_idx), byte_len);
+        // Value type arrays without references need no barrier, references get one for the whole range
+        if (!dest_class->byval_arg.valuetype || vm::Class::HasReferences(dest_class))
+            gc::GarbageCollector::SetWriteBarrier((void**)destAddr, byte_len);
 
         return true;
     }
@@ -267,7 +284,7 @@ namespace System
     void Array::ClearInternal(Il2CppArray* arr, int32_t index, int32_t count)
     {
         int sz = il2cpp_array_element_size(arr->klass);
-        memset(il2cpp_array_addr_with_size(arr, sz, index), 0, count * sz);
+        utils::MemoryCopy::Zero(il2cpp_array_addr_with_size(arr, sz, index), (size_t)count * sz);
     }
 
     void Array::SetValue(Il2CppArray* thisPtr, Il2CppObject* value, Il2CppArray* indices)
@@ -2,6 +2,7 @@
 #include <memory>
 #include "icalls/mscorlib/System/Buffer.h"
 #include "il2cpp-class-internals.h"
+#include "utils/MemoryCopy.h"
 #include "vm/Array.h"
 #include "vm/Class.h"
 #include "vm/Exception.h"
@@ -63,10 +64,8 @@ namespace System
         char* src_buf = ((char*)il2cpp_array_addr_with_size(src, Class::GetInstanceSize(src->klass->element_class), 0)) + srcOffsetBytes;
         char* dest_buf = ((char*)il2cpp_array_addr_with_size(dest, Class::GetInstanceSize(dest->klass->element_class), 0)) + dstOffsetBytes;
 
-        if (src != dest)
-            memcpy(dest_buf, src_buf, count);
-        else
-            memmove(dest_buf, src_buf, count); /* Source and dest are the same array */
+        // Handles the source and destination being the same array
+        utils::MemoryCopy::Move(dest_buf, src_buf, count);
 
         return true;
     }
@@ -81,7 +80,7 @@ namespace System
 
     void Buffer::InternalMemcpy(uint8_t* dest, uint8_t* src, int32_t count)
     {
-        memcpy(dest, src, count);
+        utils::MemoryCopy::Move(dest, src, count);
     }
 } /* namespace System */
 } /* namespace mscorlib */
@@ -23,12 +23,8 @@ namespace System
 
     bool Enum::InternalHasFlag(Il2CppObject* thisPtr, Il2CppObject* flags)
     {
-        Il2CppClass* enumClass = vm::Class::FromIl2CppType(vm::Class::GetEnumBaseType(thisPtr->klass));
-        int32_t size = vm::Class::GetValueSize(enumClass, NULL);
-        uint64_t a_val = 0, b_val = 0;
-
-        memcpy(&a_val, vm::Object::Unbox(thisPtr), size);
-        memcpy(&b_val, vm::Object::Unbox(flags), size);
+        uint64_t a_val = vm::Enum::GetValue(thisPtr);
+        uint64_t b_val = vm::Enum::GetValue(flags);
 
         return (a_val & b_val) == b_val;
     }
@@ -39,28 +35,31 @@ namespace System
         Il2CppClass *basetype = thisPtr->klass->element_class;
         IL2CPP_ASSERT(basetype);
 
-        if (basetype == il2cpp_defaults.sbyte_class)
-            return *((int8_t*)data);
-        if (basetype == il2cpp_defaults.byte_class)
-            return *((uint8_t*)data);
-        if (basetype == il2cpp_defaults.char_class)
-            return *((Il2CppChar*)data);
-        if (basetype == il2cpp_defaults.uint16_class)
-            return *((uint16_t*)data);
-        if (basetype == il2cpp_defaults.int16_class)
-            return *((uint16_t*)data);
-        if (basetype == il2cpp_defaults.uint32_class)
-            return *((uint32_t*)data);
-        if (basetype == il2cpp_defaults.int32_class)
-            return *((int32_t*)data);
-        if (basetype == il2cpp_defaults.uint64_class || basetype == il2cpp_defaults.int64_class)
+        switch (basetype->byval_arg.type)
         {
-            int64_t value = *((int64_t*)data);
-            return (int32_t)(value & 0xffffffff) ^ (int32_t)(value >> 32);
+            case IL2CPP_TYPE_I1:
+                return *((int8_t*)data);
+            case IL2CPP_TYPE_U1:
+                return *((uint8_t*)data);
+            case IL2CPP_TYPE_CHAR:
+                return *((Il2CppChar*)data);
+            case IL2CPP_TYPE_U2:
+            case IL2CPP_TYPE_I2:
+                return *((uint16_t*)data);
+            case IL2CPP_TYPE_U4:
+                return *((uint32_t*)data);
+            case IL2CPP_TYPE_I4:
+                return *((int32_t*)data);
+            case IL2CPP_TYPE_U8:
+            case IL2CPP_TYPE_I8:
+            {
+                int64_t value = *((int64_t*)data);
+                return (int32_t)(value & 0xffffffff) ^ (int32_t)(value >> 32);
+            }
+            default:
+                IL2CPP_ASSERT(0 && "System_Enum_get_hashcode_icall");
+                return 0;
         }
-
-        IL2CPP_ASSERT(0 && "System_Enum_get_hashcode_icall");
-        return 0;
     }
 
     int32_t Enum::InternalCompareTo(Il2CppObject* o1, Il2CppObject* o2)
@@ -124,7 +123,7 @@ namespace System
 
         IL2CPP_ASSERT(thisPtr->klass->enumtype);
 
-        Il2CppClass* enumClass = vm::Class::FromIl2CppType(vm::Class::GetEnumBaseType(thisPtr->klass));
+        Il2CppClass* enumClass = thisPtr->klass->element_class;
         Il2CppObject* res = vm::Object::New(enumClass);
         void* dst = (char*)res + sizeof(Il2CppObject);
         void* src = (char*)thisPtr + sizeof(Il2CppObject);
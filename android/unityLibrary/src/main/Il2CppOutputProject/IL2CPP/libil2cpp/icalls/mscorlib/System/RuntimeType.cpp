@@ -8,7 +8,10 @@
 #include "RuntimeTypeHandle.h"
 #include "Type.h"
 #include "metadata/GenericMetadata.h"
+#include "os/FastReaderReaderWriterLock.h"
 #include "utils/Functional.h"
+#include "utils/HashUtils.h"
+#include "utils/Il2CppHashMap.h"
 #include "utils/Il2CppHashSet.h"
 #include "utils/StringUtils.h"
 #include "utils/dynamic_array.h"
@@ -25,6 +28,7 @@
 #include "vm/String.h"
 #include "vm/Type.h"
 
+#include <algorithm>
 #include <vector>
 #include <set>
 
@@ -55,19 +59,7 @@ namespace System
         }
     };
 
-    typedef Il2CppHashMap<const EventInfo*, Il2CppClass*, Il2CppEventInfoHash, Il2CppEventInfoCompare> EventMap;
-
-    struct PropertyPair
-    {
-        const PropertyInfo *property;
-        Il2CppClass* originalType;
-
-        PropertyPair(const PropertyInfo *property, Il2CppClass* originalType) : property(property), originalType(originalType)
-        {
-        }
-    };
-
-    typedef std::vector<PropertyPair> PropertyPairVector;
+    typedef Il2CppHashSet<const EventInfo*, Il2CppEventInfoHash, Il2CppEventInfoCompare> EventSet;
 
     static bool PropertyEqual(const PropertyInfo* prop1, const PropertyInfo* prop2)
     {
@@ -78,14 +70,23 @@ namespace System
         return vm::Method::IsSameOverloadSignature(prop1, prop2);
     }
 
-    static bool PropertyPairVectorContains(const PropertyPairVector& properties, const PropertyInfo* property)
+    struct Il2CppPropertyInfoHash
+    {
+        size_t operator()(const PropertyInfo* property) const
+        {
+            return il2cpp::utils::StringUtils::Hash(property->name);
+        }
+    };
+
+    struct Il2CppPropertyInfoCompare
     {
-        for (PropertyPairVector::const_iterator it = properties.begin(), end = properties.end(); it != end; ++it)
-            if (PropertyEqual(it->property, property))
-                return true;
+        bool operator()(const PropertyInfo* prop1, const PropertyInfo* prop2) const
+        {
+            return PropertyEqual(prop1, prop2);
+        }
+    };
 
-        return false;
-    }
+    typedef Il2CppHashSet<const PropertyInfo*, Il2CppPropertyInfoHash, Il2CppPropertyInfoCompare> PropertySet;
 
     int32_t RuntimeType::GetGenericParameterPosition(Il2CppReflectionRuntimeType* type)
     {
@@ -230,70 +231,293 @@ namespace System
         return true;
     }
 
-    template<typename NameFilter>
-    static inline void CollectTypeEvents(Il2CppClass* type, Il2CppClass* const originalType, int32_t bindingFlags, EventMap& events, const NameFilter& nameFilter)
+    static inline bool ValidBindingFlagsForGetMember(uint32_t bindingFlags)
+    {
+        return (bindingFlags & BFLAGS_Static) != 0 || (bindingFlags & BFLAGS_Instance) != 0;
+    }
+
+    enum MemberListKind
+    {
+        kMemberListMethods,
+        kMemberListFields,
+        kMemberListProperties,
+        kMemberListEvents
+    };
+
+    // The flags that decide which members a hierarchy walk collects. IgnoreCase and the binder flags only
+    // matter to the name filter or to managed code, so they are left out of the cache key.
+    static const uint32_t kMemberListBindingFlagsMask = BFLAGS_DeclaredOnly | BFLAGS_Instance | BFLAGS_Static | BFLAGS_Public | BFLAGS_NonPublic | BFLAGS_FlattenHierarchy;
+
+    // Members of a class that pass the access and static checks for one set of binding flags, in the order
+    // the hierarchy walk visits them. Classes are never unloaded, so lists are kept for the lifetime of the runtime.
+    struct MemberList
+    {
+        // Every matching member, including methods overridden and properties hidden further down the hierarchy
+        VoidPtrArray candidates;
+        std::vector<const char*> names;
+        // Indices into candidates ordered by name, for case sensitive lookups
+        std::vector<uint32_t> byName;
+        // candidates without the overridden methods and hidden properties, the result when no name is given
+        VoidPtrArray members;
+        // One past the highest slot used by a virtual method in candidates
+        uint32_t slotCount;
+
+        MemberList() : slotCount(0)
+        {
+        }
+    };
+
+    struct MemberListKey
+    {
+        const Il2CppClass* klass;
+        uint32_t kindAndFlags;
+
+        MemberListKey() : klass(NULL), kindAndFlags(0)
+        {
+        }
+
+        MemberListKey(const Il2CppClass* klass_, MemberListKind kind, uint32_t bindingFlags) : klass(klass_), kindAndFlags(((uint32_t)kind << 24) | (bindingFlags & kMemberListBindingFlagsMask))
+        {
+        }
+    };
+
+    struct MemberListKeyHash
+    {
+        size_t operator()(const MemberListKey& key) const
+        {
+            return utils::HashUtils::Combine(utils::HashUtils::AlignedPointerHash(key.klass), key.kindAndFlags);
+        }
+    };
+
+    struct MemberListKeyEquals
+    {
+        bool operator()(const MemberListKey& left, const MemberListKey& right) const
+        {
+            return left.klass == right.klass && left.kindAndFlags == right.kindAndFlags;
+        }
+    };
+
+    typedef Il2CppHashMap<MemberListKey, MemberList*, MemberListKeyHash, MemberListKeyEquals> MemberListMap;
+
+    static MemberListMap s_MemberLists;
+    static os::FastReaderReaderWriterLock s_MemberListsLock;
+
+    static inline void AddCandidate(MemberList& list, const void* member, const char* name)
+    {
+        list.candidates.push_back(const_cast<void*>(member));
+        list.names.push_back(name);
+    }
+
+    static void CollectTypeMethods(Il2CppClass* type, const Il2CppClass* originalType, uint32_t bindingFlags, MemberList& list)
+    {
+        void* iter = NULL;
+        while (const MethodInfo* method = vm::Class::GetMethods(type, &iter))
+        {
+            if ((method->flags & METHOD_ATTRIBUTE_RT_SPECIAL_NAME) != 0 && (strcmp(method->name, ".ctor") == 0 || strcmp(method->name, ".cctor") == 0))
+                continue;
+
+            if (CheckMemberMatch(method, type, originalType, bindingFlags, utils::functional::TrueFilter()))
+            {
+                if ((method->flags & METHOD_ATTRIBUTE_VIRTUAL) != 0)
+                    list.slotCount = std::max<uint32_t>(list.slotCount, method->slot + 1);
+
+                AddCandidate(list, method, method->name);
+            }
+        }
+    }
+
+    static void CollectTypeFields(Il2CppClass* type, const Il2CppClass* originalType, uint32_t bindingFlags, MemberList& list)
+    {
+        void* iter = NULL;
+        while (const FieldInfo* field = vm::Class::GetFields(type, &iter))
+        {
+            if (CheckMemberMatch(field, type, originalType, bindingFlags, utils::functional::TrueFilter()))
+                AddCandidate(list, field, field->name);
+        }
+    }
+
+    static void CollectTypeProperties(Il2CppClass* type, const Il2CppClass* originalType, uint32_t bindingFlags, MemberList& list)
+    {
+        void* iter = NULL;
+        while (const PropertyInfo* property = vm::Class::GetProperties(type, &iter))
+        {
+            if (CheckMemberMatch(property, type, originalType, bindingFlags, utils::functional::TrueFilter()))
+                AddCandidate(list, property, property->name);
+        }
+    }
+
+    static void CollectTypeEvents(Il2CppClass* type, const Il2CppClass* originalType, EventSet& seen, MemberList& list)
     {
         void* iter = NULL;
         while (const EventInfo* event = vm::Class::GetEvents(type, &iter))
         {
-            if (CheckMemberMatch(event, type, originalType, bindingFlags, nameFilter))
+            // Events cannot be overloaded, so the first event of a name hides the ones further up for every name filter
+            if (!CheckMemberMatch(event, type, originalType, BFLAGS_MatchAll, utils::functional::TrueFilter()) || seen.find(event) != seen.end())
+                continue;
+
+            seen.insert(event);
+            AddCandidate(list, event, event->name);
+        }
+    }
+
+    // Drops the virtual methods whose slot an earlier method already filled and the properties an earlier
+    // property with the same name and signature hides. Only the members that passed the name filter take
+    // part, exactly as when the filter was applied during the hierarchy walk.
+    static void RemoveHiddenMembers(MemberListKind kind, const VoidPtrArray& candidates, uint32_t slotCount, VoidPtrArray& members)
+    {
+        if (kind == kMemberListMethods)
+        {
+            std::vector<bool> filledSlots(slotCount, false);
+            for (size_t i = 0; i < candidates.size(); i++)
             {
-                if (events.find(event) != events.end())
+                const MethodInfo* method = static_cast<const MethodInfo*>(candidates[i]);
+                if ((method->flags & METHOD_ATTRIBUTE_VIRTUAL) != 0)
+                {
+                    if (filledSlots[method->slot])
+                        continue;
+
+                    filledSlots[method->slot] = true;
+                }
+
+                members.push_back(candidates[i]);
+            }
+        }
+        else if (kind == kMemberListProperties)
+        {
+            PropertySet seen;
+            for (size_t i = 0; i < candidates.size(); i++)
+            {
+                const PropertyInfo* property = static_cast<const PropertyInfo*>(candidates[i]);
+                if (seen.find(property) != seen.end())
                     continue;
 
-                events[event] = originalType;
+                seen.insert(property);
+                members.push_back(candidates[i]);
             }
         }
+        else
+        {
+            members.assign(candidates.begin(), candidates.end());
+        }
     }
 
-    static inline bool ValidBindingFlagsForGetMember(uint32_t bindingFlags)
+    struct MemberNameLess
     {
-        return (bindingFlags & BFLAGS_Static) != 0 || (bindingFlags & BFLAGS_Instance) != 0;
-    }
+        const std::vector<const char*>& names;
 
-    template<typename NameFilter>
-    static inline Il2CppArray* GetEventsImpl(Il2CppReflectionType* type, int listType, Il2CppReflectionType* reflectedType, const NameFilter& nameFilter)
+        MemberNameLess(const std::vector<const char*>& names_) : names(names_)
+        {
+        }
+
+        bool operator()(uint32_t left, uint32_t right) const
+        {
+            return strcmp(names[left], names[right]) < 0;
+        }
+
+        bool operator()(uint32_t left, const char* right) const
+        {
+            return strcmp(names[left], right) < 0;
+        }
+
+        bool operator()(const char* left, uint32_t right) const
+        {
+            return strcmp(left, names[right]) < 0;
+        }
+    };
+
+    static MemberList* BuildMemberList(Il2CppClass* klass, MemberListKind kind, uint32_t bindingFlags)
     {
-        if (type->type->byref)
-            return vm::Array::New(il2cpp_defaults.event_info_class, 0);
+        MemberList* list = new MemberList();
+        EventSet seenEvents;
 
-        EventMap events;
-        Il2CppClass* typeInfo = vm::Class::FromIl2CppType(type->type);
+        for (Il2CppClass* type = klass; type != NULL; type = vm::Class::GetParent(type))
+        {
+            switch (kind)
+            {
+                case kMemberListMethods:
+                    CollectTypeMethods(type, klass, bindingFlags, *list);
+                    break;
+                case kMemberListFields:
+                    CollectTypeFields(type, klass, bindingFlags, *list);
+                    break;
+                case kMemberListProperties:
+                    CollectTypeProperties(type, klass, bindingFlags, *list);
+                    break;
+                case kMemberListEvents:
+                    CollectTypeEvents(type, klass, seenEvents, *list);
+                    break;
+            }
+
+            // Events are always reported for the whole hierarchy
+            if (kind != kMemberListEvents && (bindingFlags & BFLAGS_DeclaredOnly) != 0)
+                break;
+        }
 
-        CollectTypeEvents(typeInfo, typeInfo, BFLAGS_MatchAll, events, nameFilter);
+        list->byName.resize(list->candidates.size());
+        for (uint32_t i = 0; i < (uint32_t)list->byName.size(); i++)
+            list->byName[i] = i;
+        std::stable_sort(list->byName.begin(), list->byName.end(), MemberNameLess(list->names));
 
-        Il2CppClass* const originalType = typeInfo;
-        typeInfo = vm::Class::GetParent(typeInfo);
+        RemoveHiddenMembers(kind, list->candidates, list->slotCount, list->members);
+
+        return list;
+    }
+
+    static const MemberList& GetMemberList(Il2CppClass* klass, MemberListKind kind, uint32_t bindingFlags)
+    {
+        MemberListKey key(klass, kind, bindingFlags);
 
-        while (typeInfo != NULL)
         {
-            CollectTypeEvents(typeInfo, originalType, BFLAGS_MatchAll, events, nameFilter);
-            typeInfo = vm::Class::GetParent(typeInfo);
+            os::FastReaderReaderWriterAutoSharedLock lock(&s_MemberListsLock);
+            MemberListMap::const_iterator it = s_MemberLists.find(key);
+            if (it != s_MemberLists.end())
+                return *it->second;
         }
 
-        int i = 0;
-        Il2CppArray* result = vm::Array::NewCached(il2cpp_defaults.event_info_class, (il2cpp_array_size_t)events.size());
+        // Built outside of the lock, the class accessors take their own locks and may run type initialization
+        MemberList* list = BuildMemberList(klass, kind, bindingFlags & kMemberListBindingFlagsMask);
 
-        for (EventMap::const_iterator iter = events.begin(); iter != events.end(); iter++)
+        os::FastReaderReaderWriterAutoExclusiveLock lock(&s_MemberListsLock);
+        MemberListMap::const_iterator it = s_MemberLists.find(key);
+        if (it != s_MemberLists.end())
         {
-            il2cpp_array_setref(result, i, vm::Reflection::GetEventObject(iter->second, iter->first.key));
-            i++;
+            delete list;
+            return *it->second;
         }
 
-        return result;
+        s_MemberLists.add(key, list);
+        return *list;
     }
 
-    static Il2CppArray* GetEventsByName(Il2CppReflectionType* _this, Il2CppString* name, int listType, Il2CppReflectionType* reflectedType)
+    // Returns a fresh array of the members in list whose name matches, or all of them when name is NULL
+    static MonoGPtrArray* GetMembersByName(const MemberList& list, MemberListKind kind, const char* name, bool ignoreCase)
     {
         if (name == NULL)
-            return GetEventsImpl(_this, listType, reflectedType, utils::functional::TrueFilter());
+            return void_ptr_array_to_gptr_array(list.members);
 
-        if (listType == MLISTTYPE_CaseInsensitive)
+        VoidPtrArray matches;
+        if (ignoreCase)
         {
-            return GetEventsImpl(_this, listType, reflectedType, utils::functional::Filter<std::string, utils::VmStringUtils::CaseInsensitiveComparer>(utils::StringUtils::Utf16ToUtf8(name->chars)));
+            for (size_t i = 0; i < list.candidates.size(); i++)
+            {
+                if (utils::VmStringUtils::CaseInsensitiveEquals(name, list.names[i]))
+                    matches.push_back(list.candidates[i]);
+            }
+        }
+        else
+        {
+            std::pair<std::vector<uint32_t>::const_iterator, std::vector<uint32_t>::const_iterator> range = std::equal_range(list.byName.begin(), list.byName.end(), name, MemberNameLess(list.names));
+            if (range.first == range.second)
+                return empty_gptr_array();
+
+            // byName is a stable sort, so equal names are still in hierarchy order
+            for (std::vector<uint32_t>::const_iterator it = range.first; it != range.second; ++it)
+                matches.push_back(list.candidates[*it]);
         }
 
-        return GetEventsImpl(_this, listType, reflectedType, utils::functional::Filter<std::string, utils::VmStringUtils::CaseSensitiveComparer>(utils::StringUtils::Utf16ToUtf8(name->chars)));
+        VoidPtrArray members;
+        RemoveHiddenMembers(kind, matches, list.slotCount, members);
+        return void_ptr_array_to_gptr_array(members);
     }
 
     intptr_t RuntimeType::GetConstructors_native(Il2CppReflectionRuntimeType* thisPtr, int32_t bindingAttr)
@@ -355,208 +579,40 @@ namespace System
 
     intptr_t RuntimeType::GetEvents_native(Il2CppReflectionRuntimeType* thisPtr, intptr_t name, int32_t listType)
     {
-        Il2CppReflectionMonoEvent *event;
-        VoidPtrArray res_array;
-
         if (thisPtr->type.type->byref)
         {
             return reinterpret_cast<intptr_t>(empty_gptr_array());
         }
 
-        res_array.reserve(4);
-
-        const char *utf8_name = reinterpret_cast<const char*>(name);
-        Il2CppString* nameStr = utf8_name == NULL ? NULL : il2cpp::vm::String::New(utf8_name);
-        Il2CppArray* events = GetEventsByName(&thisPtr->type, nameStr, listType, &thisPtr->type);
-
-        for (unsigned int i = 0; i < il2cpp::vm::Array::GetLength(events); i++)
-        {
-            event = il2cpp_array_get(events, Il2CppReflectionMonoEvent*, i);
-            res_array.push_back((EventInfo*)event->eventInfo);
-        }
-
-        return reinterpret_cast<intptr_t>(void_ptr_array_to_gptr_array(res_array));
-    }
-
-    template<typename NameFilter>
-    static inline void CollectTypeFields(Il2CppClass* type, const Il2CppClass* const originalType, int32_t bindingFlags, std::vector<FieldInfo*>& fields, const NameFilter& nameFilter)
-    {
-        void* iterator = NULL;
-        FieldInfo* field = NULL;
-        while ((field = vm::Class::GetFields(type, &iterator)) != NULL)
-        {
-            if (CheckMemberMatch(field, type, originalType, bindingFlags, nameFilter))
-                fields.push_back(field);
-        }
-    }
-
-    template<typename NameFilter>
-    static inline Il2CppArray* GetFieldsImpl(Il2CppReflectionType* _this, int bindingFlags, Il2CppReflectionType* reflectedType, const NameFilter& nameFilter)
-    {
-        if (reflectedType->type->byref || !ValidBindingFlagsForGetMember(bindingFlags))
-            return vm::Array::New(il2cpp_defaults.field_info_class, 0);
-
-        std::vector<FieldInfo*> fields;
-        Il2CppClass* typeInfo = vm::Class::FromIl2CppType(reflectedType->type);
-        Il2CppClass* const originalType = typeInfo;
-
-        CollectTypeFields(typeInfo, typeInfo, bindingFlags, fields, nameFilter);
-
-        if ((bindingFlags & BFLAGS_DeclaredOnly) == 0)
-        {
-            typeInfo = typeInfo->parent;
-
-            while (typeInfo != NULL)
-            {
-                CollectTypeFields(typeInfo, originalType, bindingFlags, fields, nameFilter);
-                typeInfo = typeInfo->parent;
-            }
-        }
-
-        size_t fieldCount = fields.size();
-        Il2CppArray* result = vm::Array::NewCached(il2cpp_defaults.field_info_class, (il2cpp_array_size_t)fieldCount);
-
-        for (size_t i = 0; i < fieldCount; i++)
-        {
-            il2cpp_array_setref(result, i, vm::Reflection::GetFieldObject(originalType, fields[i]));
-        }
-
-        return result;
-    }
-
-    static Il2CppArray* GetFieldsByName(Il2CppReflectionType* _this, Il2CppString* name, int bindingFlags, Il2CppReflectionType* reflectedType)
-    {
-        if (name == NULL)
-            return GetFieldsImpl(_this, bindingFlags, reflectedType, utils::functional::TrueFilter());
-
-        if (bindingFlags & BFLAGS_IgnoreCase)
-        {
-            return GetFieldsImpl(_this, bindingFlags, reflectedType, utils::functional::Filter<std::string, utils::VmStringUtils::CaseInsensitiveComparer>(utils::StringUtils::Utf16ToUtf8(name->chars)));
-        }
-
-        return GetFieldsImpl(_this, bindingFlags, reflectedType, utils::functional::Filter<std::string, utils::VmStringUtils::CaseSensitiveComparer>(utils::StringUtils::Utf16ToUtf8(name->chars)));
+        Il2CppClass* typeInfo = vm::Class::FromIl2CppType(thisPtr->type.type);
+        const MemberList& events = GetMemberList(typeInfo, kMemberListEvents, BFLAGS_MatchAll);
+        return reinterpret_cast<intptr_t>(GetMembersByName(events, kMemberListEvents, reinterpret_cast<const char*>(name), listType == MLISTTYPE_CaseInsensitive));
     }
 
     intptr_t RuntimeType::GetFields_native(Il2CppReflectionRuntimeType* thisPtr, intptr_t name, int32_t bindingAttr, int32_t listType)
     {
-        Il2CppReflectionField *field;
-
-        VoidPtrArray res_array;
-
-        if (thisPtr->type.type->byref)
+        if (thisPtr->type.type->byref || !ValidBindingFlagsForGetMember(bindingAttr))
         {
             return reinterpret_cast<intptr_t>(empty_gptr_array());
         }
 
-        res_array.reserve(16);
-
-        const char *utf8_name = reinterpret_cast<const char*>(name);
-        Il2CppString* nameStr = utf8_name == NULL ? NULL : il2cpp::vm::String::New(utf8_name);
-        Il2CppArray* fields = GetFieldsByName(&thisPtr->type, nameStr, bindingAttr, &thisPtr->type);
-
-        for (unsigned int i = 0; i < il2cpp::vm::Array::GetLength(fields); i++)
-        {
-            field = il2cpp_array_get(fields, Il2CppReflectionField*, i);
-            res_array.push_back(field->field);
-        }
-
-        return reinterpret_cast<intptr_t>(void_ptr_array_to_gptr_array(res_array));
-    }
-
-    template<typename NameFilter>
-    void CollectTypeMethods(Il2CppClass* type, const Il2CppClass* originalType, uint32_t bindingFlags, const NameFilter& nameFilter, std::vector<const MethodInfo*>& methods, bool(&filledSlots)[65535])
-    {
-        void* iter = NULL;
-        while (const MethodInfo* method = vm::Class::GetMethods(type, &iter))
-        {
-            if ((method->flags & METHOD_ATTRIBUTE_RT_SPECIAL_NAME) != 0 && (strcmp(method->name, ".ctor") == 0 || strcmp(method->name, ".cctor") == 0))
-                continue;
-
-            if (CheckMemberMatch(method, type, originalType, bindingFlags, nameFilter))
-            {
-                if ((method->flags & METHOD_ATTRIBUTE_VIRTUAL) != 0)
-                {
-                    if (filledSlots[method->slot])
-                        continue;
-
-                    filledSlots[method->slot] = true;
-                }
-
-                methods.push_back(method);
-            }
-        }
-    }
-
-    template<typename NameFilter>
-    static Il2CppArray* GetMethodsByNameImpl(const Il2CppType* type, uint32_t bindingFlags, const NameFilter& nameFilter)
-    {
-        std::vector<const MethodInfo*> methods;
-        bool filledSlots[65535] = { 0 };
-
-        Il2CppClass* typeInfo = vm::Class::FromIl2CppType(type);
-        Il2CppClass* const originalTypeInfo = typeInfo;
-
-        CollectTypeMethods(typeInfo, typeInfo, bindingFlags, nameFilter, methods, filledSlots);
-
-        if ((bindingFlags & BFLAGS_DeclaredOnly) == 0)
-        {
-            for (typeInfo = vm::Class::GetParent(typeInfo); typeInfo != NULL; typeInfo = vm::Class::GetParent(typeInfo))
-            {
-                CollectTypeMethods(typeInfo, originalTypeInfo, bindingFlags, nameFilter, methods, filledSlots);
-            }
-        }
-
-        size_t methodCount = methods.size();
-        Il2CppArray* result = vm::Array::NewCached(il2cpp_defaults.method_info_class, (il2cpp_array_size_t)methodCount);
-
-        for (size_t i = 0; i < methodCount; i++)
-        {
-            Il2CppReflectionMethod* method = vm::Reflection::GetMethodObject(methods[i], originalTypeInfo);
-            il2cpp_array_setref(result, i, method);
-        }
-
-        return result;
-    }
-
-    static Il2CppArray* GetMethodsByName(Il2CppReflectionType* _this, Il2CppString* name, int32_t bindingFlags, int listType, Il2CppReflectionType* type)
-    {
-        if (type->type->byref || !ValidBindingFlagsForGetMember(bindingFlags))
-            return vm::Array::NewCached(il2cpp_defaults.property_info_class, 0);
-
-        if (name != NULL)
-        {
-            if (bindingFlags & BFLAGS_IgnoreCase || listType == MLISTTYPE_CaseInsensitive)
-            {
-                return GetMethodsByNameImpl(type->type, bindingFlags, utils::functional::Filter<std::string, utils::VmStringUtils::CaseInsensitiveComparer>(utils::StringUtils::Utf16ToUtf8(name->chars)));
-            }
-
-            return GetMethodsByNameImpl(type->type, bindingFlags, utils::functional::Filter<std::string, utils::VmStringUtils::CaseSensitiveComparer>(utils::StringUtils::Utf16ToUtf8(name->chars)));
-        }
-
-        return GetMethodsByNameImpl(type->type, bindingFlags, utils::functional::TrueFilter());
+        Il2CppClass* typeInfo = vm::Class::FromIl2CppType(thisPtr->type.type);
+        const MemberList& fields = GetMemberList(typeInfo, kMemberListFields, bindingAttr);
+        return reinterpret_cast<intptr_t>(GetMembersByName(fields, kMemberListFields, reinterpret_cast<const char*>(name), (bindingAttr & BFLAGS_IgnoreCase) != 0));
     }
 
     intptr_t RuntimeType::GetMethodsByName_native(Il2CppReflectionRuntimeType* thisPtr, intptr_t namePtr, int32_t bindingAttr, int32_t listType)
     {
-        VoidPtrArray res_array;
-        Il2CppReflectionMethod *method;
-
-        if (thisPtr->type.type->byref)
+        if (thisPtr->type.type->byref || !ValidBindingFlagsForGetMember(bindingAttr))
         {
             return reinterpret_cast<intptr_t>(empty_gptr_array());
         }
 
-        const char *utf8_name = reinterpret_cast<const char*>(namePtr);
-        Il2CppString* nameStr = utf8_name == NULL ? NULL : il2cpp::vm::String::New(utf8_name);
-        Il2CppArray* methods = GetMethodsByName(&thisPtr->type, nameStr, bindingAttr, listType, &thisPtr->type);
-
-        for (unsigned int i = 0; i < il2cpp::vm::Array::GetLength(methods); i++)
-        {
-            method = il2cpp_array_get(methods, Il2CppReflectionMethod*, i);
-            res_array.push_back((MethodInfo*)method->method);
-        }
+        bool ignoreCase = (bindingAttr & BFLAGS_IgnoreCase) != 0 || listType == MLISTTYPE_CaseInsensitive;
 
-        return reinterpret_cast<intptr_t>(void_ptr_array_to_gptr_array(res_array));
+        Il2CppClass* typeInfo = vm::Class::FromIl2CppType(thisPtr->type.type);
+        const MemberList& methods = GetMemberList(typeInfo, kMemberListMethods, bindingAttr);
+        return reinterpret_cast<intptr_t>(GetMembersByName(methods, kMemberListMethods, reinterpret_cast<const char*>(namePtr), ignoreCase));
     }
 
     static inline bool CheckNestedTypeMatch(Il2CppClass* nestedType, BindingFlags bindingFlags)
@@ -634,95 +690,18 @@ namespace System
         return reinterpret_cast<intptr_t>(void_ptr_array_to_gptr_array(res_array));
     }
 
-    template<typename NameFilter>
-    static void CollectTypeProperties(Il2CppClass* type, uint32_t bindingFlags, const NameFilter& nameFilter, Il2CppClass* const originalType, PropertyPairVector& properties)
-    {
-        void* iter = NULL;
-        while (const PropertyInfo* property = vm::Class::GetProperties(type, &iter))
-        {
-            if (CheckMemberMatch(property, type, originalType, bindingFlags, nameFilter))
-            {
-                if (PropertyPairVectorContains(properties, property))
-                    continue;
-
-                properties.push_back(PropertyPair(property, originalType));
-            }
-        }
-    }
-
-    template<typename NameFilter>
-    static Il2CppArray* GetPropertiesByNameImpl(const Il2CppType* type, uint32_t bindingFlags, const NameFilter& nameFilter)
-    {
-        PropertyPairVector properties;
-        Il2CppClass* typeInfo = vm::Class::FromIl2CppType(type);
-        Il2CppClass* const originalTypeInfo = typeInfo;
-
-        properties.reserve(typeInfo->property_count);
-        CollectTypeProperties(typeInfo, bindingFlags, nameFilter, originalTypeInfo, properties);
-
-        if ((bindingFlags & BFLAGS_DeclaredOnly) == 0)
-        {
-            for (typeInfo = typeInfo->parent; typeInfo != NULL; typeInfo = typeInfo->parent)
-            {
-                CollectTypeProperties(typeInfo, bindingFlags, nameFilter, originalTypeInfo, properties);
-            }
-        }
-
-        int i = 0;
-        Il2CppArray* res = vm::Array::NewCached(il2cpp_defaults.property_info_class, (il2cpp_array_size_t)properties.size());
-
-        for (PropertyPairVector::const_iterator iter = properties.begin(); iter != properties.end(); iter++)
-        {
-            il2cpp_array_setref(res, i, vm::Reflection::GetPropertyObject(iter->originalType, iter->property));
-            i++;
-        }
-
-        return res;
-    }
-
-    static Il2CppArray* GetPropertiesByName(Il2CppReflectionType* _this, Il2CppString* name, uint32_t bindingFlags, bool ignoreCase, Il2CppReflectionType* type)
-    {
-        if (type->type->byref || !ValidBindingFlagsForGetMember(bindingFlags))
-            return vm::Array::NewCached(il2cpp_defaults.property_info_class, 0);
-
-        if (name != NULL)
-        {
-            if (ignoreCase)
-            {
-                return GetPropertiesByNameImpl(type->type, bindingFlags, utils::functional::Filter<std::string, utils::VmStringUtils::CaseInsensitiveComparer>(utils::StringUtils::Utf16ToUtf8(name->chars)));
-            }
-
-            return GetPropertiesByNameImpl(type->type, bindingFlags, utils::functional::Filter<std::string, utils::VmStringUtils::CaseSensitiveComparer>(utils::StringUtils::Utf16ToUtf8(name->chars)));
-        }
-
-        return GetPropertiesByNameImpl(type->type, bindingFlags, utils::functional::TrueFilter());
-    }
-
     intptr_t RuntimeType::GetPropertiesByName_native(Il2CppReflectionRuntimeType* thisPtr, intptr_t name, int32_t bindingAttr, int32_t listType)
     {
-        Il2CppReflectionProperty *prop;
-        VoidPtrArray res_array;
-
-        if (thisPtr->type.type->byref)
+        if (thisPtr->type.type->byref || !ValidBindingFlagsForGetMember(bindingAttr))
         {
             return reinterpret_cast<intptr_t>(empty_gptr_array());
         }
 
-        res_array.reserve(8);
-
         bool ignoreCase = listType == MLISTTYPE_CaseInsensitive;
 
-        const char *utf8_name = reinterpret_cast<const char*>(name);
-        Il2CppString* nameStr = utf8_name == NULL ? NULL : il2cpp::vm::String::New(utf8_name);
-        Il2CppArray* properties = GetPropertiesByName(&thisPtr->type, nameStr, bindingAttr, ignoreCase, &thisPtr->type);
-
-        for (unsigned int i = 0; i < il2cpp::vm::Array::GetLength(properties); i++)
-        {
-            prop = il2cpp_array_get(properties, Il2CppReflectionProperty*, i);
-            res_array.push_back((PropertyInfo*)prop->property);
-        }
-
-        return reinterpret_cast<intptr_t>(void_ptr_array_to_gptr_array(res_array));
+        Il2CppClass* typeInfo = vm::Class::FromIl2CppType(thisPtr->type.type);
+        const MemberList& properties = GetMemberList(typeInfo, kMemberListProperties, bindingAttr);
+        return reinterpret_cast<intptr_t>(GetMembersByName(properties, kMemberListProperties, reinterpret_cast<const char*>(name), ignoreCase));
     }
 
     Il2CppObject* RuntimeType::CreateInstanceInternal(Il2CppReflectionType* type)
@@ -797,16 +776,18 @@ namespace System
         else
             format = IL2CPP_TYPE_NAME_FORMAT_REFLECTION;
 
-        std::string name(vm::Type::GetName(_type->type.type, format));
-        if (name.empty())
-            return NULL;
-
         if (full_name && (_type->type.type->type == IL2CPP_TYPE_VAR || _type->type.type->type == IL2CPP_TYPE_MVAR))
         {
             return NULL;
         }
 
-        return il2cpp::vm::String::NewWrapper(name.c_str());
+        // FullName and ToString are called per object by logging and serialization code, the string is
+        // created once per type and format
+        Il2CppString* name = vm::Type::GetNameString(_type->type.type, format);
+        if (vm::String::GetLength(name) == 0)
+            return NULL;
+
+        return name;
     }
 
     Il2CppReflectionType* RuntimeType::get_DeclaringType(Il2CppReflectionRuntimeType* _this)
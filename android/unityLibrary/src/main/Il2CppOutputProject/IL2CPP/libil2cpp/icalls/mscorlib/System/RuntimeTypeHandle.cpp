@@ -12,6 +12,7 @@
 #include "vm/Reflection.h"
 #include "vm/MetadataCache.h"
 #include "vm/GenericClass.h"
+#include "vm/TypeNameCache.h"
 #include "il2cpp-api.h"
 
 #define CHECK_IF_NULL(v)    \
@@ -234,7 +235,15 @@ namespace System
 
     Il2CppReflectionType* RuntimeTypeHandle::internal_from_name(Il2CppString* name, int32_t* stackMark, Il2CppObject* callerAssembly, bool throwOnError, bool ignoreCase, bool reflectionOnly)
     {
-        std::string str = utils::StringUtils::Utf16ToUtf8(utils::StringUtils::GetChars(name));
+        const Il2CppChar* chars = utils::StringUtils::GetChars(name);
+        const int32_t length = utils::StringUtils::GetLength(name);
+
+        // A name that failed before goes the slow way again when it has to throw, the exception needs the parsed name
+        const Il2CppType* cachedType;
+        if (vm::TypeNameCache::TryGet(chars, length, ignoreCase, &cachedType) && (cachedType != NULL || !throwOnError))
+            return cachedType != NULL ? il2cpp::vm::Reflection::GetTypeObject(cachedType) : NULL;
+
+        std::string str = utils::StringUtils::Utf16ToUtf8(chars);
 
         il2cpp::vm::TypeNameParseInfo info;
         il2cpp::vm::TypeNameParser parser(str, info, false);
@@ -243,8 +252,9 @@ namespace System
         {
             if (throwOnError)
                 vm::Exception::Raise(vm::Exception::GetArgumentException("typeName", "Invalid type name"));
-            else
-                return NULL;
+
+            vm::TypeNameCache::Add(chars, length, ignoreCase, NULL, NULL);
+            return NULL;
         }
 
         vm::TypeSearchFlags searchFlags = vm::kTypeSearchFlagNone;
@@ -257,6 +267,8 @@ namespace System
 
         const Il2CppType *type = vm::Class::il2cpp_type_from_type_info(info, searchFlags);
 
+        vm::TypeNameCache::Add(chars, length, ignoreCase, &info, type);
+
         CHECK_IF_NULL(type);
 
         return il2cpp::vm::Reflection::GetTypeObject(type);
@@ -88,6 +88,17 @@ DO_API(void*, il2cpp_class_get_static_field_data, (const Il2CppClass * klass));
 DO_API(bool, il2cpp_stats_dump_to_file, (const char *path));
 DO_API(uint64_t, il2cpp_stats_get_value, (Il2CppStat stat));
 
+// metadata usage profile
+DO_API(void, il2cpp_set_metadata_usage_profile, (const char* path, int32_t preload_threads));
+DO_API(bool, il2cpp_metadata_usage_profile_write, (const char* path));
+
+// metadata file
+DO_API(void, il2cpp_set_metadata_file_hints, (int32_t hints));
+
+// startup trace
+DO_API(void, il2cpp_set_startup_trace, (const char* path));
+DO_API(bool, il2cpp_startup_trace_write, (const char* path));
+
 // domain
 DO_API(Il2CppDomain*, il2cpp_domain_get, ());
 DO_API(const Il2CppAssembly*, il2cpp_domain_assembly_open, (Il2CppDomain * domain, const char* name));
@@ -279,6 +290,7 @@ DO_API(const Il2CppClass*, il2cpp_image_get_class, (const Il2CppImage * image, s
 // Memory information
 DO_API(Il2CppManagedMemorySnapshot*, il2cpp_capture_memory_snapshot, ());
 DO_API(void, il2cpp_free_captured_memory_snapshot, (Il2CppManagedMemorySnapshot * snapshot));
+DO_API(bool, il2cpp_write_memory_snapshot, (const char* path, int32_t flags));
 
 DO_API(void, il2cpp_set_find_plugin_callback, (Il2CppSetFindPlugInCallback method));
 
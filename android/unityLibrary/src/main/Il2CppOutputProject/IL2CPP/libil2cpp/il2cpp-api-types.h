@@ -97,6 +97,13 @@ typedef enum
     IL2CPP_STAT_GENERIC_CLASS_COUNT,
     IL2CPP_STAT_INFLATED_METHOD_COUNT,
     IL2CPP_STAT_INFLATED_TYPE_COUNT,
+    IL2CPP_STAT_PINVOKE_RESOLVE_COUNT,
+    IL2CPP_STAT_PINVOKE_RESOLVE_TIME_USECS,
+    IL2CPP_STAT_METADATA_USAGE_LAZY_COUNT,
+    IL2CPP_STAT_METADATA_USAGE_PRELOAD_COUNT,
+    IL2CPP_STAT_METADATA_USAGE_PRELOAD_TIME_USECS,
+    IL2CPP_STAT_METHOD_TABLE_INIT_COUNT,
+    IL2CPP_STAT_METHOD_TABLE_INIT_TIME_USECS,
     //IL2CPP_STAT_DELEGATE_CREATIONS,
     //IL2CPP_STAT_MINOR_GC_COUNT,
     //IL2CPP_STAT_MAJOR_GC_COUNT,
@@ -104,6 +111,24 @@ typedef enum
     //IL2CPP_STAT_MAJOR_GC_TIME_USECS
 } Il2CppStat;
 
+typedef enum
+{
+    IL2CPP_METADATA_FILE_HINT_NONE = 0,
+    // Read the sections used during startup ahead of their first access
+    IL2CPP_METADATA_FILE_HINT_PREFETCH = 1 << 0,
+    // Keep the most used sections resident, subject to the process locked memory limit
+    IL2CPP_METADATA_FILE_HINT_LOCK = 1 << 1,
+    // Log the page residency of every section at load and at the end of startup
+    IL2CPP_METADATA_FILE_HINT_TRACE = 1 << 2
+} Il2CppMetadataFileHints;
+
+typedef enum
+{
+    IL2CPP_MEMORY_SNAPSHOT_NONE = 0,
+    // Deflate the records of the snapshot file with zlib
+    IL2CPP_MEMORY_SNAPSHOT_COMPRESS = 1 << 0
+} Il2CppMemorySnapshotFlags;
+
 typedef enum
 {
     IL2CPP_UNHANDLED_POLICY_LEGACY,
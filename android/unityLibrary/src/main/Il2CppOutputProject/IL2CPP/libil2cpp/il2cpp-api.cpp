@@ -16,6 +16,8 @@
 #include "vm/InternalCalls.h"
 #include "vm/Liveness.h"
 #include "vm/MemoryInformation.h"
+#include "vm/MetadataFileHints.h"
+#include "vm/MetadataUsageProfile.h"
 #include "vm/Method.h"
 #include "vm/Monitor.h"
 #include "vm/Object.h"
@@ -26,6 +28,7 @@
 #include "vm/Reflection.h"
 #include "vm/Runtime.h"
 #include "vm/StackTrace.h"
+#include "vm/StartupTrace.h"
 #include "vm/String.h"
 #include "vm/Thread.h"
 #include "vm/Type.h"
@@ -470,6 +473,13 @@ bool il2cpp_stats_dump_to_file(const char *path)
     fs << "Initialized class count: " << il2cpp_stats_get_value(IL2CPP_STAT_INITIALIZED_CLASS_COUNT) << "\n";
     fs << "Generic instance count: " << il2cpp_stats_get_value(IL2CPP_STAT_GENERIC_INSTANCE_COUNT) << "\n";
     fs << "Generic class count: " << il2cpp_stats_get_value(IL2CPP_STAT_GENERIC_CLASS_COUNT) << "\n";
+    fs << "P/Invoke resolve count: " << il2cpp_stats_get_value(IL2CPP_STAT_PINVOKE_RESOLVE_COUNT) << "\n";
+    fs << "P/Invoke resolve time (us): " << il2cpp_stats_get_value(IL2CPP_STAT_PINVOKE_RESOLVE_TIME_USECS) << "\n";
+    fs << "Metadata usages resolved lazily: " << il2cpp_stats_get_value(IL2CPP_STAT_METADATA_USAGE_LAZY_COUNT) << "\n";
+    fs << "Metadata usages preloaded: " << il2cpp_stats_get_value(IL2CPP_STAT_METADATA_USAGE_PRELOAD_COUNT) << "\n";
+    fs << "Metadata usage preload time (us): " << il2cpp_stats_get_value(IL2CPP_STAT_METADATA_USAGE_PRELOAD_TIME_USECS) << "\n";
+    fs << "Method tables initialized: " << il2cpp_stats_get_value(IL2CPP_STAT_METHOD_TABLE_INIT_COUNT) << "\n";
+    fs << "Method table init time (us): " << il2cpp_stats_get_value(IL2CPP_STAT_METHOD_TABLE_INIT_TIME_USECS) << "\n";
 
     fs.close();
 
@@ -514,6 +524,27 @@ uint64_t il2cpp_stats_get_value(Il2CppStat stat)
         case IL2CPP_STAT_INFLATED_TYPE_COUNT:
             return il2cpp_runtime_stats.inflated_type_count;
 
+        case IL2CPP_STAT_PINVOKE_RESOLVE_COUNT:
+            return il2cpp_runtime_stats.pinvoke_resolve_count;
+
+        case IL2CPP_STAT_PINVOKE_RESOLVE_TIME_USECS:
+            return il2cpp_runtime_stats.pinvoke_resolve_time_usecs;
+
+        case IL2CPP_STAT_METADATA_USAGE_LAZY_COUNT:
+            return il2cpp_runtime_stats.metadata_usage_lazy_count;
+
+        case IL2CPP_STAT_METADATA_USAGE_PRELOAD_COUNT:
+            return il2cpp_runtime_stats.metadata_usage_preload_count;
+
+        case IL2CPP_STAT_METADATA_USAGE_PRELOAD_TIME_USECS:
+            return il2cpp_runtime_stats.metadata_usage_preload_time_usecs;
+
+        case IL2CPP_STAT_METHOD_TABLE_INIT_COUNT:
+            return il2cpp_runtime_stats.method_table_init_count;
+
+        case IL2CPP_STAT_METHOD_TABLE_INIT_TIME_USECS:
+            return il2cpp_runtime_stats.method_table_init_time_usecs;
+
             /*case IL2CPP_STAT_DELEGATE_CREATIONS:
                 return il2cpp_runtime_stats.delegate_creations;
 
@@ -533,6 +564,31 @@ uint64_t il2cpp_stats_get_value(Il2CppStat stat)
     return 0;
 }
 
+void il2cpp_set_metadata_usage_profile(const char* path, int32_t preload_threads)
+{
+    il2cpp::vm::MetadataUsageProfile::SetPreloadProfile(path, preload_threads);
+}
+
+bool il2cpp_metadata_usage_profile_write(const char* path)
+{
+    return il2cpp::vm::MetadataUsageProfile::Write(path);
+}
+
+void il2cpp_set_metadata_file_hints(int32_t hints)
+{
+    il2cpp::vm::MetadataFileHints::SetHints(hints);
+}
+
+void il2cpp_set_startup_trace(const char* path)
+{
+    il2cpp::vm::StartupTrace::SetOutputPath(path);
+}
+
+bool il2cpp_startup_trace_write(const char* path)
+{
+    return il2cpp::vm::StartupTrace::Write(path);
+}
+
 // domain
 Il2CppDomain* il2cpp_domain_get()
 {
@@ -1386,6 +1442,11 @@ void il2cpp_free_captured_memory_snapshot(Il2CppManagedMemorySnapshot* snapshot)
     MemoryInformation::FreeCapturedManagedMemorySnapshot(snapshot);
 }
 
+bool il2cpp_write_memory_snapshot(const char* path, int32_t flags)
+{
+    return MemoryInformation::WriteManagedMemorySnapshot(path, flags);
+}
+
 void il2cpp_set_find_plugin_callback(Il2CppSetFindPlugInCallback method)
 {
     il2cpp::vm::PlatformInvoke::SetFindPluginCallback(method);
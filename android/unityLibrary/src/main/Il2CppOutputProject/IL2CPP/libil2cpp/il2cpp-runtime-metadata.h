@@ -51,13 +51,13 @@ typedef struct Il2CppType
     {
         // We have this dummy field first because pre C99 compilers (MSVC) can only initializer the first value in a union.
         void* dummy;
-        TypeDefinitionIndex __klassIndex; /* for VALUETYPE and CLASS at startup */
-        Il2CppMetadataTypeHandle typeHandle; /* for VALUETYPE and CLASS at runtime */
+        TypeDefinitionIndex __klassIndex; /* for VALUETYPE and CLASS until first use */
+        Il2CppMetadataTypeHandle typeHandle; /* for VALUETYPE and CLASS after first use, read through MetadataCache::GetTypeHandleFromType */
         const Il2CppType *type;   /* for PTR and SZARRAY */
         Il2CppArrayType *array; /* for ARRAY */
         //MonoMethodSignature *method;
-        GenericParameterIndex __genericParameterIndex; /* for VAR and MVAR at startup */
-        Il2CppMetadataGenericParameterHandle genericParameterHandle; /* for VAR and MVAR at runtime */
+        GenericParameterIndex __genericParameterIndex; /* for VAR and MVAR until first use */
+        Il2CppMetadataGenericParameterHandle genericParameterHandle; /* for VAR and MVAR after first use, read through MetadataCache::GetGenericParameterFromType */
         Il2CppGenericClass *generic_class; /* for GENERICINST */
     } data;
     unsigned int attrs    : 16; /* param attributes or field flags */
@@ -16,6 +16,13 @@ struct Il2CppRuntimeStats
     std::atomic<uint64_t> generic_class_count;
     std::atomic<uint64_t> inflated_method_count;
     std::atomic<uint64_t> inflated_type_count;
+    std::atomic<uint64_t> pinvoke_resolve_count;
+    std::atomic<uint64_t> pinvoke_resolve_time_usecs;
+    std::atomic<uint64_t> metadata_usage_lazy_count;
+    std::atomic<uint64_t> metadata_usage_preload_count;
+    std::atomic<uint64_t> metadata_usage_preload_time_usecs;
+    std::atomic<uint64_t> method_table_init_count;
+    std::atomic<uint64_t> method_table_init_time_usecs;
     // uint64_t delegate_creations;
     // uint64_t minor_gc_count;
     // uint64_t major_gc_count;
@@ -233,8 +233,18 @@ namespace metadata
             return NULL;
 
         const Il2CppType** inflatedArgs = (const Il2CppType**)alloca(inst->type_argc * sizeof(Il2CppType*));
+        bool changed = false;
         for (size_t i = 0; i < inst->type_argc; i++)
+        {
             inflatedArgs[i] = InflateIfNeeded(inst->type_argv[i], context, inflateMethodVars);
+            changed |= inflatedArgs[i] != inst->type_argv[i];
+        }
+
+        // Instances are interned, when no argument needed inflating the instance is its own inflation
+        // and there is nothing to look up
+        if (!changed)
+            return inst;
+
         return MetadataCache::GetGenericInst(inflatedArgs, inst->type_argc);
     }
 
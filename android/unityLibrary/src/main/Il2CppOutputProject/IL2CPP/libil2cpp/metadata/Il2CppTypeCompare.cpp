@@ -1,6 +1,7 @@
 #include "il2cpp-config.h"
 #include "il2cpp-class-internals.h"
 #include "Il2CppTypeCompare.h"
+#include "vm/MetadataCache.h"
 
 namespace il2cpp
 {
@@ -32,7 +33,7 @@ namespace metadata
         {
             case IL2CPP_TYPE_VALUETYPE:
             case IL2CPP_TYPE_CLASS:
-                return Compare(t1->data.typeHandle, t2->data.typeHandle);
+                return Compare(vm::MetadataCache::GetTypeHandleFromType(t1), vm::MetadataCache::GetTypeHandleFromType(t2));
 
             case IL2CPP_TYPE_PTR:
             case IL2CPP_TYPE_SZARRAY:
@@ -79,7 +80,7 @@ namespace metadata
             }
             case IL2CPP_TYPE_VAR:
             case IL2CPP_TYPE_MVAR:
-                return Compare(t1->data.genericParameterHandle, t2->data.genericParameterHandle);
+                return Compare(vm::MetadataCache::GetGenericParameterFromType(t1), vm::MetadataCache::GetGenericParameterFromType(t2));
             default:
                 return 0;
         }
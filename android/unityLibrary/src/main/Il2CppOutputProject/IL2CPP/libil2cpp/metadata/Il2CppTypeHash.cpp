@@ -3,6 +3,7 @@
 #include "Il2CppTypeHash.h"
 #include "utils/StringUtils.h"
 #include "utils/HashUtils.h"
+#include "vm/MetadataCache.h"
 
 using il2cpp::utils::HashUtils;
 using il2cpp::utils::StringUtils;
@@ -27,7 +28,7 @@ namespace metadata
             case IL2CPP_TYPE_VALUETYPE:
             case IL2CPP_TYPE_CLASS:
             {
-                return HashUtils::Combine(hash, reinterpret_cast<size_t>(t1->data.typeHandle));
+                return HashUtils::Combine(hash, reinterpret_cast<size_t>(vm::MetadataCache::GetTypeHandleFromType(t1)));
             }
             case IL2CPP_TYPE_SZARRAY:
             case IL2CPP_TYPE_PTR:
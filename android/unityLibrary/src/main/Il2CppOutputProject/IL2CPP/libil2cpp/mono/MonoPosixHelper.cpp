@@ -3,41 +3,74 @@
 #include <string.h>
 #include <stdlib.h>
 
+#include <algorithm>
+#include <deque>
+#include <vector>
+
 #include "../external/zlib/zlib.h"
 
+#include "os/Environment.h"
+#include "os/Mutex.h"
+#include "os/Thread.h"
 #include "vm/Exception.h"
 
-#define BUFFER_SIZE 4096
+#include "Baselib.h"
+#include "Cpp/ConditionVariable.h"
+#include "Cpp/Lock.h"
+#include "Cpp/ReentrantLock.h"
+
+// The managed feeder reads at most 4 KB per callback, a larger input buffer would not save any calls.
+// Compressed output is handed to managed code in one callback per buffer, which loops over it without
+// leaving managed code, so a larger buffer cuts the number of native to managed transitions.
+#define INFLATE_BUFFER_SIZE 4096
+#define DEFLATE_BUFFER_SIZE (64 * 1024)
+#define STREAM_POOL_SIZE 2
+// Parallel compression hands out the input in blocks of this size, each primed with the preceding
+// 32 KB (the largest distance deflate can refer back to) so the ratio stays close to serial deflate.
+#define PARALLEL_BLOCK_SIZE (128 * 1024)
+#define PARALLEL_DICTIONARY_SIZE (32 * 1024)
+#define PARALLEL_MAX_THREADS 8
 #define ARGUMENT_ERROR -10
 #define IO_ERROR -11
 
 typedef int32_t (*read_write_func)(intptr_t buffer, int32_t length, intptr_t gchandle);
 
+struct ParallelDeflate;
+
 struct ZStream
 {
     z_stream *stream;
+    ParallelDeflate *parallel;
     uint8_t *buffer;
+    uint32_t buffer_size;
     read_write_func func;
     void *gchandle;
     uint8_t compress;
+    uint8_t gzip;
     uint8_t eof;
     uint32_t total_in;
 };
 
+// Initialized zlib states are kept around once a stream closes, deflate state in particular is large
+// and expensive to set up. Resetting a state keeps its window bits, so the pools are split by mode.
+static baselib::ReentrantLock s_StreamPoolLock;
+static z_stream* s_StreamPool[2][2][STREAM_POOL_SIZE];
+static int32_t s_StreamPoolCount[2][2];
+
 static int32_t write_to_managed(ZStream *stream)
 {
     int32_t n;
     z_stream *zs;
 
     zs = stream->stream;
-    if (zs->avail_out != BUFFER_SIZE)
+    if (zs->avail_out != stream->buffer_size)
     {
         intptr_t buffer_ptr = reinterpret_cast<intptr_t>(stream->buffer);
         intptr_t gchandle_ptr = reinterpret_cast<intptr_t>(stream->gchandle);
 
-        n = stream->func(buffer_ptr, BUFFER_SIZE - zs->avail_out, gchandle_ptr);
+        n = stream->func(buffer_ptr, stream->buffer_size - zs->avail_out, gchandle_ptr);
         zs->next_out = stream->buffer;
-        zs->avail_out = BUFFER_SIZE;
+        zs->avail_out = stream->buffer_size;
         if (n < 0)
             return IO_ERROR;
     }
@@ -48,7 +81,7 @@ static int32_t flush_internal(ZStream *stream, bool is_final)
 {
     int32_t status;
 
-    if (!stream->compress)
+    if (!stream->compress || stream->func == NULL)
         return 0;
 
     if (!is_final && stream->stream->avail_in != 0)
@@ -71,24 +104,19 @@ static void z_free(void *opaque, void *ptr)
     free(ptr);
 }
 
-intptr_t CreateZStream(int32_t compress, uint8_t gzip, Il2CppMethodPointer func_ptr, intptr_t gchandle)
+static z_stream* acquire_z_stream(bool compress, bool gzip)
 {
-    z_stream *z;
-    int32_t retval;
-    ZStream *result;
-
-    intptr_t result_ptr = 0;
-    read_write_func func = (read_write_func)func_ptr;
-
-    if (func == NULL)
-        return result_ptr;
-
-#if !defined(ZLIB_VERNUM) || (ZLIB_VERNUM < 0x1204)
-    // Older versions of zlib do not support raw deflate or gzip
-    return NULL;
-#endif
+    {
+        il2cpp::os::FastAutoLock lock(&s_StreamPoolLock);
+        int32_t& count = s_StreamPoolCount[compress][gzip];
+        if (count > 0)
+            return s_StreamPool[compress][gzip][--count];
+    }
 
-    z = (z_stream*)calloc(1, sizeof(z_stream));
+    int32_t retval;
+    z_stream *z = (z_stream*)calloc(1, sizeof(z_stream));
+    z->zalloc = z_alloc;
+    z->zfree = z_free;
     if (compress)
     {
         retval = deflateInit2(z, Z_DEFAULT_COMPRESSION, Z_DEFLATED, gzip ? 31 : -15, 8, Z_DEFAULT_STRATEGY);
@@ -101,24 +129,428 @@ intptr_t CreateZStream(int32_t compress, uint8_t gzip, Il2CppMethodPointer func_
     if (retval != Z_OK)
     {
         free(z);
-        return result_ptr;
+        return NULL;
     }
 
-    z->zalloc = z_alloc;
-    z->zfree = z_free;
-    result = (ZStream*)calloc(1, sizeof(ZStream));
+    return z;
+}
+
+static void release_z_stream(z_stream *z, bool compress, bool gzip)
+{
+    int32_t retval = compress ? deflateReset(z) : inflateReset(z);
+    if (retval == Z_OK)
+    {
+        il2cpp::os::FastAutoLock lock(&s_StreamPoolLock);
+        int32_t& count = s_StreamPoolCount[compress][gzip];
+        if (count < STREAM_POOL_SIZE)
+        {
+            s_StreamPool[compress][gzip][count++] = z;
+            return;
+        }
+    }
+
+    if (compress)
+        deflateEnd(z);
+    else
+        inflateEnd(z);
+    free(z);
+}
+
+struct ParallelDeflateJob
+{
+    std::vector<uint8_t> input;
+    std::vector<uint8_t> dictionary;
+    std::vector<uint8_t> output;
+    int32_t flush;
+    int32_t status;
+    bool done;
+};
+
+// Each block is deflated on its own as raw deflate data. Every block but the last ends with a sync flush,
+// which byte aligns it without marking the last deflate block, so the blocks concatenated in order form
+// one valid stream. The gzip header and trailer are written around them by the stream's own thread.
+struct ParallelDeflate
+{
+    baselib::Lock lock;
+    baselib::ConditionVariable work_available;
+    baselib::ConditionVariable job_done;
+    std::deque<ParallelDeflateJob*> queue;
+    std::deque<ParallelDeflateJob*> in_flight;
+    std::vector<il2cpp::os::Thread*> threads;
+    int32_t max_threads;
+    bool shutdown;
+
+    std::vector<uint8_t> block;
+    std::vector<uint8_t> dictionary;
+    uint64_t total_in;
+    uint32_t crc;
+    bool header_written;
+
+    explicit ParallelDeflate(int32_t maxThreads) : work_available(lock), job_done(lock), max_threads(maxThreads), shutdown(false), total_in(0), crc(0), header_written(false)
+    {
+        block.reserve(PARALLEL_BLOCK_SIZE);
+    }
+};
+
+static int32_t deflate_block(z_stream *z, ParallelDeflateJob *job)
+{
+    int32_t status;
+    size_t used;
+
+    if (z == NULL || deflateReset(z) != Z_OK)
+        return Z_MEM_ERROR;
+
+    if (!job->dictionary.empty())
+    {
+        status = deflateSetDictionary(z, job->dictionary.data(), (uInt)job->dictionary.size());
+        if (status != Z_OK)
+            return status;
+    }
+
+    // The bound covers the block and the sync flush marker, so one deflate call is normally enough
+    job->output.resize(deflateBound(z, (uLong)job->input.size()) + 16);
+    z->next_in = job->input.data();
+    z->avail_in = (uInt)job->input.size();
+    z->next_out = job->output.data();
+    z->avail_out = (uInt)job->output.size();
+
+    status = deflate(z, job->flush);
+    while (status == Z_OK && z->avail_out == 0)
+    {
+        used = job->output.size();
+        job->output.resize(used * 2);
+        z->next_out = job->output.data() + used;
+        z->avail_out = (uInt)(job->output.size() - used);
+        status = deflate(z, job->flush);
+    }
+
+    job->output.resize(job->output.size() - z->avail_out);
+    z->next_in = NULL;
+    z->next_out = NULL;
+
+    if (job->flush == Z_FINISH)
+        return status == Z_STREAM_END ? 0 : (status < 0 ? status : Z_BUF_ERROR);
+    return status == Z_OK ? 0 : status;
+}
+
+static void parallel_deflate_worker(void *arg)
+{
+    ParallelDeflate *pd = (ParallelDeflate*)arg;
+    ParallelDeflateJob *job;
+    z_stream *z = acquire_z_stream(true, false);
+
+    pd->lock.Acquire();
+    for (;;)
+    {
+        while (pd->queue.empty() && !pd->shutdown)
+            pd->work_available.Wait();
+        if (pd->queue.empty())
+            break;
+
+        job = pd->queue.front();
+        pd->queue.pop_front();
+        pd->lock.Release();
+
+        job->status = deflate_block(z, job);
+
+        pd->lock.Acquire();
+        job->done = true;
+        pd->job_done.NotifyAll();
+    }
+    pd->lock.Release();
+
+    if (z != NULL)
+        release_z_stream(z, true, false);
+}
+
+static int32_t parallel_write_to_managed(ZStream *stream, uint8_t *buffer, size_t length)
+{
+    intptr_t gchandle_ptr = reinterpret_cast<intptr_t>(stream->gchandle);
+    int32_t n;
+
+    // Managed code loops over whatever it is given, but the length it takes is an int
+    while (length > 0)
+    {
+        int32_t chunk = (int32_t)std::min(length, (size_t)INT32_MAX);
+        n = stream->func(reinterpret_cast<intptr_t>(buffer), chunk, gchandle_ptr);
+        if (n < 0)
+            return IO_ERROR;
+        buffer += chunk;
+        length -= chunk;
+    }
+    return 0;
+}
+
+static int32_t parallel_write_header(ZStream *stream)
+{
+    ParallelDeflate *pd = stream->parallel;
+    // No file name, no modification time, OS unknown
+    uint8_t header[10] = { 0x1f, 0x8b, Z_DEFLATED, 0, 0, 0, 0, 0, 0, 0xff };
+
+    if (pd->header_written || !stream->gzip)
+        return 0;
+
+    pd->header_written = true;
+    return parallel_write_to_managed(stream, header, sizeof(header));
+}
+
+static int32_t parallel_write_trailer(ZStream *stream)
+{
+    ParallelDeflate *pd = stream->parallel;
+    uint8_t trailer[8];
+    uint32_t size = (uint32_t)pd->total_in;
+
+    if (!stream->gzip)
+        return 0;
+
+    for (int i = 0; i < 4; i++)
+    {
+        trailer[i] = (uint8_t)(pd->crc >> (i * 8));
+        trailer[i + 4] = (uint8_t)(size >> (i * 8));
+    }
+    return parallel_write_to_managed(stream, trailer, sizeof(trailer));
+}
+
+// Writes out finished blocks in submission order, waiting until at most max_pending are left unwritten
+static int32_t parallel_emit(ZStream *stream, size_t max_pending)
+{
+    ParallelDeflate *pd = stream->parallel;
+    ParallelDeflateJob *job;
+    int32_t status = 0;
+
+    for (;;)
+    {
+        pd->lock.Acquire();
+        if (pd->in_flight.empty() || (!pd->in_flight.front()->done && pd->in_flight.size() <= max_pending))
+        {
+            pd->lock.Release();
+            return status;
+        }
+
+        job = pd->in_flight.front();
+        while (!job->done)
+            pd->job_done.Wait();
+        pd->in_flight.pop_front();
+        pd->lock.Release();
+
+        // Managed code is called without holding the lock, so the workers keep going meanwhile
+        status = job->status;
+        if (status == 0)
+            status = parallel_write_header(stream);
+        if (status == 0)
+            status = parallel_write_to_managed(stream, job->output.data(), job->output.size());
+        delete job;
+
+        if (status != 0)
+        {
+            stream->eof = 1;
+            return status;
+        }
+    }
+}
+
+static int32_t parallel_submit(ZStream *stream, bool last)
+{
+    ParallelDeflate *pd = stream->parallel;
+    ParallelDeflateJob *job = new ParallelDeflateJob();
+    bool inline_job;
+
+    job->input.swap(pd->block);
+    job->dictionary = pd->dictionary;
+    job->flush = last ? Z_FINISH : Z_SYNC_FLUSH;
+    job->status = 0;
+    job->done = false;
+
+    if (job->input.size() >= PARALLEL_DICTIONARY_SIZE)
+    {
+        pd->dictionary.assign(job->input.end() - PARALLEL_DICTIONARY_SIZE, job->input.end());
+    }
+    else
+    {
+        pd->dictionary.insert(pd->dictionary.end(), job->input.begin(), job->input.end());
+        if (pd->dictionary.size() > PARALLEL_DICTIONARY_SIZE)
+            pd->dictionary.erase(pd->dictionary.begin(), pd->dictionary.end() - PARALLEL_DICTIONARY_SIZE);
+    }
+    pd->block.reserve(PARALLEL_BLOCK_SIZE);
+
+    // Workers are started as blocks come in, small streams never pay for a thread. A stream that ends
+    // before it filled a block, or whose threads could not be started, is compressed right here.
+    if (!last && pd->threads.size() < (size_t)pd->max_threads)
+    {
+        il2cpp::os::Thread *thread = new il2cpp::os::Thread();
+        if (thread->Run(parallel_deflate_worker, pd) == il2cpp::os::kErrorCodeSuccess)
+            pd->threads.push_back(thread);
+        else
+            delete thread;
+    }
+    inline_job = pd->threads.empty();
+
+    if (inline_job)
+    {
+        z_stream *z = acquire_z_stream(true, false);
+        job->status = deflate_block(z, job);
+        job->done = true;
+        if (z != NULL)
+            release_z_stream(z, true, false);
+    }
+
+    pd->lock.Acquire();
+    pd->in_flight.push_back(job);
+    if (!inline_job)
+    {
+        pd->queue.push_back(job);
+        pd->work_available.Notify(1);
+    }
+    pd->lock.Release();
+
+    // Bounds the memory held by compressed blocks that cannot be written out yet
+    return parallel_emit(stream, (size_t)pd->max_threads * 2);
+}
+
+static int32_t parallel_write(ZStream *stream, uint8_t *buffer, int32_t length)
+{
+    ParallelDeflate *pd = stream->parallel;
+    int32_t status;
+    size_t chunk;
+
+    while (length > 0)
+    {
+        chunk = std::min((size_t)length, PARALLEL_BLOCK_SIZE - pd->block.size());
+        pd->block.insert(pd->block.end(), buffer, buffer + chunk);
+        if (stream->gzip)
+            pd->crc = crc32(pd->crc, buffer, (uInt)chunk);
+        pd->total_in += chunk;
+        buffer += chunk;
+        length -= (int32_t)chunk;
+
+        if (pd->block.size() == PARALLEL_BLOCK_SIZE)
+        {
+            status = parallel_submit(stream, false);
+            if (status != 0)
+                return status;
+        }
+    }
+    return 0;
+}
+
+static int32_t parallel_flush(ZStream *stream)
+{
+    int32_t status;
+
+    // An earlier write to managed code failed, the output is already broken
+    if (stream->eof)
+        return IO_ERROR;
+
+    if (!stream->parallel->block.empty())
+    {
+        status = parallel_submit(stream, false);
+        if (status != 0)
+            return status;
+    }
+    return parallel_emit(stream, 0);
+}
+
+static int32_t parallel_finish(ZStream *stream)
+{
+    int32_t status;
+
+    // Do not append the last block and a trailer to output that is missing earlier blocks
+    if (stream->eof)
+        return IO_ERROR;
+
+    if (stream->parallel->total_in == 0)
+        return 0;
+
+    status = parallel_submit(stream, true);
+    if (status == 0)
+        status = parallel_emit(stream, 0);
+    if (status == 0)
+        status = parallel_write_trailer(stream);
+    return status;
+}
+
+static void parallel_destroy(ParallelDeflate *pd)
+{
+    pd->lock.Acquire();
+    pd->shutdown = true;
+    // Blocks nobody picked up yet are dropped, they are still owned through in_flight
+    pd->queue.clear();
+    pd->work_available.NotifyAll();
+    pd->lock.Release();
+
+    for (size_t i = 0; i < pd->threads.size(); i++)
+    {
+        pd->threads[i]->Join();
+        delete pd->threads[i];
+    }
+
+    for (size_t i = 0; i < pd->in_flight.size(); i++)
+        delete pd->in_flight[i];
+
+    delete pd;
+}
+
+static ZStream* create_z_stream(int32_t compress, uint8_t gzip, read_write_func func, intptr_t gchandle)
+{
+#if !defined(ZLIB_VERNUM) || (ZLIB_VERNUM < 0x1204)
+    // Older versions of zlib do not support raw deflate or gzip
+    return NULL;
+#endif
+
+    z_stream *z = acquire_z_stream(compress != 0, gzip != 0);
+    if (z == NULL)
+        return NULL;
+
+    ZStream *result = (ZStream*)calloc(1, sizeof(ZStream));
     result->stream = z;
     result->func = func;
     result->gchandle = reinterpret_cast<void*>(gchandle);
-    result->compress = compress;
-    result->buffer = (uint8_t*)malloc(BUFFER_SIZE * sizeof(uint8_t));
+    result->compress = compress != 0;
+    result->gzip = gzip != 0;
 
-    result->stream->next_out = result->buffer;
-    result->stream->avail_out = BUFFER_SIZE;
+    if (func != NULL)
+    {
+        result->buffer_size = compress ? DEFLATE_BUFFER_SIZE : INFLATE_BUFFER_SIZE;
+        result->buffer = (uint8_t*)malloc(result->buffer_size * sizeof(uint8_t));
+        result->stream->next_out = result->buffer;
+        result->stream->avail_out = result->buffer_size;
+    }
     result->stream->total_in = 0;
 
-    result_ptr = reinterpret_cast<intptr_t>(result);
-    return result_ptr;
+    return result;
+}
+
+intptr_t CreateZStream(int32_t compress, uint8_t gzip, Il2CppMethodPointer func_ptr, intptr_t gchandle)
+{
+    read_write_func func = (read_write_func)func_ptr;
+    bool parallel = (compress & ZSTREAM_PARALLEL_COMPRESS) != 0;
+    int32_t threads;
+
+    if (func == NULL)
+        return 0;
+
+    compress &= ~ZSTREAM_PARALLEL_COMPRESS;
+    threads = std::min(il2cpp::os::Environment::GetProcessorCount(), PARALLEL_MAX_THREADS);
+    if (!parallel || !compress || threads < 2)
+        return reinterpret_cast<intptr_t>(create_z_stream(compress, gzip, func, gchandle));
+
+#if !defined(ZLIB_VERNUM) || (ZLIB_VERNUM < 0x1204)
+    return 0;
+#endif
+
+    ZStream *result = (ZStream*)calloc(1, sizeof(ZStream));
+    result->parallel = new ParallelDeflate(threads);
+    result->func = func;
+    result->gchandle = reinterpret_cast<void*>(gchandle);
+    result->compress = 1;
+    result->gzip = gzip != 0;
+
+    return reinterpret_cast<intptr_t>(result);
+}
+
+intptr_t CreateZStreamDirect(int32_t compress, uint8_t gzip)
+{
+    return reinterpret_cast<intptr_t>(create_z_stream(compress, gzip, NULL, 0));
 }
 
 int32_t CloseZStream(intptr_t zstream)
@@ -132,7 +564,12 @@ int32_t CloseZStream(intptr_t zstream)
         return ARGUMENT_ERROR;
 
     status = 0;
-    if (stream->compress)
+    if (stream->parallel != NULL)
+    {
+        status = parallel_finish(stream);
+        parallel_destroy(stream->parallel);
+    }
+    else if (stream->compress && stream->func != NULL)
     {
         if (stream->stream->total_in > 0)
         {
@@ -146,15 +583,11 @@ int32_t CloseZStream(intptr_t zstream)
             if (status == Z_STREAM_END)
                 status = flush_status;
         }
-        deflateEnd(stream->stream);
-    }
-    else
-    {
-        inflateEnd(stream->stream);
     }
 
+    if (stream->stream != NULL)
+        release_z_stream(stream->stream, stream->compress != 0, stream->gzip != 0);
     free(stream->buffer);
-    free(stream->stream);
     memset(stream, 0, sizeof(ZStream));
     free(stream);
 
@@ -164,6 +597,8 @@ int32_t CloseZStream(intptr_t zstream)
 int32_t Flush(intptr_t zstream)
 {
     ZStream *stream = (ZStream*)zstream;
+    if (stream->parallel != NULL)
+        return parallel_flush(stream);
     return flush_internal(stream, false);
 }
 
@@ -176,7 +611,7 @@ int32_t ReadZStream(intptr_t zstream, intptr_t zbuffer, int32_t length)
     ZStream *stream = (ZStream*)zstream;
     uint8_t *buffer = (uint8_t*)zbuffer;
 
-    if (stream == NULL || buffer == NULL || length < 0)
+    if (stream == NULL || stream->func == NULL || stream->parallel != NULL || buffer == NULL || length < 0)
         return ARGUMENT_ERROR;
 
     if (stream->eof)
@@ -192,7 +627,7 @@ int32_t ReadZStream(intptr_t zstream, intptr_t zbuffer, int32_t length)
             intptr_t buffer_ptr = reinterpret_cast<intptr_t>(stream->buffer);
             intptr_t gchandle_ptr = reinterpret_cast<intptr_t>(stream->gchandle);
 
-            n = stream->func(buffer_ptr, BUFFER_SIZE, gchandle_ptr);
+            n = stream->func(buffer_ptr, stream->buffer_size, gchandle_ptr);
             if (n < 0)
                 n = 0;
 
@@ -236,12 +671,18 @@ int32_t WriteZStream(intptr_t zstream, intptr_t zbuffer, int32_t length)
     ZStream *stream = (ZStream*)zstream;
     uint8_t *buffer = (uint8_t*)zbuffer;
 
-    if (stream == NULL || buffer == NULL || length < 0)
+    if (stream == NULL || stream->func == NULL || buffer == NULL || length < 0)
         return ARGUMENT_ERROR;
 
     if (stream->eof)
         return IO_ERROR;
 
+    if (stream->parallel != NULL)
+    {
+        status = parallel_write(stream, buffer, length);
+        return status != 0 ? status : length;
+    }
+
     zs = stream->stream;
     zs->next_in = buffer;
     zs->avail_in = length;
@@ -250,7 +691,7 @@ int32_t WriteZStream(intptr_t zstream, intptr_t zbuffer, int32_t length)
         if (zs->avail_out == 0)
         {
             zs->next_out = stream->buffer;
-            zs->avail_out = BUFFER_SIZE;
+            zs->avail_out = stream->buffer_size;
         }
         status = deflate(stream->stream, Z_NO_FLUSH);
         if (status != Z_OK && status != Z_STREAM_END)
@@ -266,6 +707,54 @@ int32_t WriteZStream(intptr_t zstream, intptr_t zbuffer, int32_t length)
     return length;
 }
 
+int32_t ProcessZStreamDirect(intptr_t zstream, intptr_t input, int32_t input_length, int32_t *input_consumed, intptr_t output, int32_t output_length, int32_t *output_produced, int32_t finish)
+{
+    int32_t status;
+    z_stream *zs;
+
+    ZStream *stream = (ZStream*)zstream;
+
+    if (stream == NULL || stream->func != NULL || input_length < 0 || output_length < 0 || input_consumed == NULL || output_produced == NULL)
+        return ARGUMENT_ERROR;
+
+    if ((input == 0 && input_length > 0) || (output == 0 && output_length > 0))
+        return ARGUMENT_ERROR;
+
+    *input_consumed = 0;
+    *output_produced = 0;
+
+    if (stream->eof)
+        return Z_STREAM_END;
+
+    zs = stream->stream;
+    zs->next_in = reinterpret_cast<uint8_t*>(input);
+    zs->avail_in = input_length;
+    zs->next_out = reinterpret_cast<uint8_t*>(output);
+    zs->avail_out = output_length;
+
+    if (stream->compress)
+        status = deflate(zs, finish ? Z_FINISH : Z_NO_FLUSH);
+    else
+        status = inflate(zs, Z_SYNC_FLUSH);
+
+    *input_consumed = input_length - zs->avail_in;
+    *output_produced = output_length - zs->avail_out;
+    // The caller's buffers are only pinned for the duration of this call
+    zs->next_in = NULL;
+    zs->avail_in = 0;
+    zs->next_out = NULL;
+    zs->avail_out = 0;
+
+    if (status == Z_STREAM_END)
+        stream->eof = 1;
+
+    // Running out of input or output space is not an error here, the caller supplies more on the next call
+    if (status == Z_BUF_ERROR)
+        return Z_OK;
+
+    return status;
+}
+
 // The following methods are used by LinuxNetworkChange
 // Which the implementation for System.Net.NetworkInformation.NetworkChange on linux
 // These are here we throw a NotImplemented exception rather than getting an entry point not found
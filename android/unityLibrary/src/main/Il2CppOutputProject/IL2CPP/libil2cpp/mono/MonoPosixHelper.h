@@ -5,6 +5,12 @@
 #include "il2cpp-config.h"
 #include "il2cpp-object-internals.h"
 
+// Or'ed into the compress argument of CreateZStream to deflate on several threads. The input is cut
+// into blocks that worker threads compress independently, the output is still a single stream in the
+// requested format. Written data is only handed to the callback once its block has been compressed,
+// Flush forces out everything written so far. Ignored for decompression and on single core devices.
+#define ZSTREAM_PARALLEL_COMPRESS 0x100
+
 extern "C"
 {
     struct ZStream;
@@ -15,6 +21,13 @@ extern "C"
     IL2CPP_EXPORT int32_t ReadZStream(intptr_t zstream, intptr_t buffer, int32_t length);
     IL2CPP_EXPORT int32_t WriteZStream(intptr_t zstream, intptr_t buffer, int32_t length);
 
+    // Streams created by CreateZStreamDirect have no managed callback. Each ProcessZStreamDirect call
+    // inflates or deflates straight from the caller's input buffer into its output buffer, both of which
+    // the caller pins and sizes, and reports how much of each was used. Returns Z_OK, Z_STREAM_END or a
+    // negative error. They are released with CloseZStream.
+    IL2CPP_EXPORT intptr_t CreateZStreamDirect(int32_t compress, uint8_t gzip);
+    IL2CPP_EXPORT int32_t ProcessZStreamDirect(intptr_t zstream, intptr_t input, int32_t inputLength, int32_t* inputConsumed, intptr_t output, int32_t outputLength, int32_t* outputProduced, int32_t finish);
+
     IL2CPP_EXPORT extern intptr_t CreateNLSocket();
     IL2CPP_EXPORT extern int32_t ReadEvents(intptr_t sock, intptr_t buffer, int32_t count, int32_t size);
     IL2CPP_EXPORT extern intptr_t CloseNLSocket(intptr_t sock);
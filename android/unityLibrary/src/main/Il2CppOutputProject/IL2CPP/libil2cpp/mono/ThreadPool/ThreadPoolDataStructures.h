@@ -5,7 +5,8 @@
 #include "Baselib.h"
 #include "Cpp/Atomic.h"
 #include "Cpp/ReentrantLock.h"
-#include "Cpp/ConditionVariable.h"
+#include "Cpp/BinarySemaphore.h"
+#include "Cpp/Lock.h"
 
 #include "os/Mutex.h"
 
@@ -30,6 +31,14 @@ struct ThreadPoolDomain
     int32_t outstanding_request;
 };
 
+/* lives on the stack of a parked worker, linked into ThreadPool::parked_threads while it waits */
+struct ThreadPoolParkedWorker
+{
+    baselib::BinarySemaphore wakeup;
+    ThreadPoolParkedWorker* next;
+    bool parked; /* cleared by the thread that pops it off parked_threads */
+};
+
 struct ThreadPoolHillClimbing
 {
     int32_t wave_period;
@@ -72,10 +81,12 @@ struct ThreadPool
 
     std::vector<ThreadPoolDomain*> domains;
     baselib::ReentrantLock domains_lock;
+    baselib::atomic<int32_t> outstanding_request_total; /* sum of outstanding_request over all domains, readable without domains_lock */
+    baselib::atomic<int32_t> spinning_threads; /* workers looking for a request before parking */
 
     std::vector<Il2CppInternalThread*> working_threads;
     int32_t parked_threads_count;
-    baselib::ConditionVariable parked_threads_cond;
+    ThreadPoolParkedWorker* parked_threads; /* LIFO, the most recently parked worker is woken first */
     baselib::Lock active_threads_lock; /* protect access to working_threads and parked_threads */
 
     uint32_t worker_creation_current_second;
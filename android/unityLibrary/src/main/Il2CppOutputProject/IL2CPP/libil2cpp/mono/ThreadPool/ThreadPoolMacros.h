@@ -25,3 +25,8 @@
 
 #define CPU_USAGE_LOW 80
 #define CPU_USAGE_HIGH 95
+
+/* number of yields an idle worker spends looking for a new request before it parks, 0 disables spinning */
+#define WORKER_SPIN_COUNT 64
+/* spin count handed to the wake up semaphore once a worker is parked */
+#define WORKER_PARK_SPIN_COUNT 200
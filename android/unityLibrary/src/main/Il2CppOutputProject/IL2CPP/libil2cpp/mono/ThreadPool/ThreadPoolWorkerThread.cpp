@@ -11,6 +11,8 @@
 #include "vm/Thread.h"
 #include "os/Time.h"
 
+#include <algorithm>
+
 #define WORKER_CREATION_MAX_PER_SEC 10
 
 static void remove_working_thread(Il2CppInternalThread *thread)
@@ -48,26 +50,91 @@ static void thread_info_uninstall_interrupt(bool *interrupted)
 
 static void worker_wait_interrupt(void* data)
 {
+    ThreadPoolParkedWorker* worker = (ThreadPoolParkedWorker*)data;
+
     g_ThreadPool->active_threads_lock.Acquire();
-    g_ThreadPool->parked_threads_cond.Notify(1);
+    worker->wakeup.Release();
     g_ThreadPool->active_threads_lock.Release();
 }
 
+/* LOCKING: threadpool->active_threads_lock must be held */
+static void remove_parked_worker(ThreadPoolParkedWorker* worker)
+{
+    ThreadPoolParkedWorker** link = &g_ThreadPool->parked_threads;
+    while (*link != worker)
+    {
+        IL2CPP_ASSERT(*link);
+        link = &(*link)->next;
+    }
+
+    *link = worker->next;
+    worker->parked = false;
+}
+
+/* return true if a request showed up while spinning, false if the worker should park
+ * spinning runs inside WorkerThreadParkStateHolder, so the counter already reports a spinning worker as parked */
+static bool worker_spin(void)
+{
+    ThreadPoolCounter counter;
+
+    if (WORKER_SPIN_COUNT == 0)
+        return false;
+
+    // Cap the number of spinners, so an idle pool does not burn every core the heuristic granted it
+    counter.as_int64_t = COUNTER_READ();
+    int32_t max_spinning = std::max(1, counter._.max_working / 2);
+    if (g_ThreadPool->spinning_threads++ >= max_spinning)
+    {
+        g_ThreadPool->spinning_threads--;
+        return false;
+    }
+
+    bool found = false;
+    for (int i = 0; i < WORKER_SPIN_COUNT && !il2cpp::vm::Runtime::IsShuttingDown(); ++i)
+    {
+        if (g_ThreadPool->outstanding_request_total.load(baselib::memory_order_acquire) > 0)
+        {
+            found = true;
+            break;
+        }
+
+        il2cpp::vm::Thread::YieldInternal();
+    }
+
+    g_ThreadPool->spinning_threads--;
+
+    // worker_request does not wake anybody while a worker spins, so check once more after we stopped being visible
+    if (!found && g_ThreadPool->outstanding_request_total > 0)
+        found = true;
+
+    // This worker serves one request, hand the others to a parked worker so they run in parallel
+    if (found && g_ThreadPool->outstanding_request_total > 1)
+        worker_try_unpark();
+
+    return found;
+}
+
 /* return true if timeout, false otherwise (worker unpark or interrupt) */
-static bool worker_park(void)
+static bool worker_park(bool spin)
 {
     bool timeout = false;
 
     //mono_trace (G_LOG_LEVEL_DEBUG, MONO_TRACE_THREADPOOL, "[%p] current worker parking", mono_native_thread_id_get ());
 
+    if (spin && worker_spin())
+        return false;
+
     il2cpp::gc::GarbageCollector::SetSkipThread(true);
 
     g_ThreadPool->active_threads_lock.Acquire();
 
-    if (!il2cpp::vm::Runtime::IsShuttingDown())
+    // A request that came in after the last check could not have woken us, so take it instead of sleeping.
+    // worker_request bumps outstanding_request_total before it looks for a parked worker under active_threads_lock.
+    if (!il2cpp::vm::Runtime::IsShuttingDown() && (!spin || g_ThreadPool->outstanding_request_total == 0))
     {
         static void* rand_handle = NULL;
         Il2CppInternalThread *thread_internal;
+        ThreadPoolParkedWorker worker;
         bool interrupted = false;
 
         if (!rand_handle)
@@ -80,15 +147,30 @@ static bool worker_park(void)
         g_ThreadPool->parked_threads_count += 1;
         remove_working_thread(thread_internal);
 
-        thread_info_install_interrupt(worker_wait_interrupt, NULL, &interrupted);
+        worker.next = g_ThreadPool->parked_threads;
+        worker.parked = true;
+        g_ThreadPool->parked_threads = &worker;
+
+        thread_info_install_interrupt(worker_wait_interrupt, &worker, &interrupted);
         if (interrupted)
             goto done;
-        if (g_ThreadPool->parked_threads_cond.TimedWait(baselib::timeout_ms(il2cpp::vm::Random::Next(&rand_handle, 5 * 1000, 60 * 1000))) == false)
-            timeout = true;
+
+        {
+            uint32_t timeout_ms = il2cpp::vm::Random::Next(&rand_handle, 5 * 1000, 60 * 1000);
+            g_ThreadPool->active_threads_lock.Release();
+            bool woken = worker.wakeup.TryTimedAcquire(baselib::timeout_ms(timeout_ms), WORKER_PARK_SPIN_COUNT);
+            g_ThreadPool->active_threads_lock.Acquire();
+
+            // A worker still linked in after the wait timed out was not claimed by worker_try_unpark
+            if (!woken && worker.parked)
+                timeout = true;
+        }
 
         thread_info_uninstall_interrupt(&interrupted);
 
     done:
+        if (worker.parked)
+            remove_parked_worker(&worker);
         g_ThreadPool->working_threads.push_back(thread_internal);
         g_ThreadPool->parked_threads_count -= 1;
     }
@@ -209,6 +291,7 @@ struct WorkerThreadJobStateHolder
     {
         tpdomain->outstanding_request--;
         IL2CPP_ASSERT(tpdomain->outstanding_request >= 0);
+        g_ThreadPool->outstanding_request_total--;
 
         IL2CPP_ASSERT(tpdomain->domain);
         IL2CPP_ASSERT(tpdomain->domain->threadpool_jobs >= 0);
@@ -237,7 +320,8 @@ static void worker_thread(void* data)
         {
             WorkerThreadParkStateHolder threadParkState(workerThreadState);
 
-            if (worker_park())
+            // A retiring worker was asked to step back by the heuristic, so it parks without looking for more work
+            if (worker_park(!workerThreadState.retire))
                 break;
 
             workerThreadState.retire = false;
@@ -139,7 +139,10 @@ static void* cpu_info_create()
 
 
 ThreadPool::ThreadPool() :
+    outstanding_request_total(0),
+    spinning_threads(0),
     parked_threads_count(0),
+    parked_threads(NULL),
     worker_creation_current_second(-1),
     worker_creation_current_count(0),
     heuristic_completions(0),
@@ -152,8 +155,7 @@ ThreadPool::ThreadPool() :
     limit_io_min(0),
     limit_io_max(0),
     cpu_usage(0),
-    suspended(false),
-    parked_threads_cond(active_threads_lock)
+    suspended(false)
 {
     counters.as_int64_t = 0;
     cpu_usage_state = cpu_info_create();
@@ -253,7 +255,8 @@ static void cleanup (void)
 		worker_kill (working_threads[i]);
 
 	/* unpark all g_ThreadPool->parked_threads */
-	g_ThreadPool->parked_threads_cond.NotifyAll();
+	while (worker_try_unpark())
+		;
 }
 
 bool threadpool_ms_enqueue_work_item (Il2CppDomain *domain, Il2CppObject *work_item)
@@ -307,15 +310,19 @@ static ThreadPoolDomain* domain_get(Il2CppDomain *domain, bool create)
 
 bool worker_try_unpark()
 {
-	bool worker_unparked = true;
+	bool worker_unparked = false;
 
 	g_ThreadPool->active_threads_lock.AcquireScoped([&worker_unparked] {
-		if (g_ThreadPool->parked_threads_count == 0)
-			worker_unparked = false;
-		else
-			g_ThreadPool->parked_threads_cond.Notify(1);
+		ThreadPoolParkedWorker *worker = g_ThreadPool->parked_threads;
+		if (worker) {
+			g_ThreadPool->parked_threads = worker->next;
+			worker->parked = false;
+			/* released under active_threads_lock so the worker cannot return from worker_park before we are done with it */
+			worker->wakeup.Release();
+			worker_unparked = true;
+		}
 	});
-	
+
 	return worker_unparked;
 }
 
@@ -340,6 +347,7 @@ static bool worker_request (Il2CppDomain *domain)
 	tpdomain = domain_get (domain, true);
 	IL2CPP_ASSERT(tpdomain);
 	tpdomain->outstanding_request ++;
+	g_ThreadPool->outstanding_request_total++;
 
 	/*mono_trace (G_LOG_LEVEL_DEBUG, MONO_TRACE_THREADPOOL, "[%p] request worker, domain = %p, outstanding_request = %d",
 		mono_native_thread_id_get (), tpdomain->domain, tpdomain->outstanding_request);*/
@@ -351,6 +359,10 @@ static bool worker_request (Il2CppDomain *domain)
 
 	monitor_ensure_running ();
 
+	/* a spinning worker sees outstanding_request_total before it parks, no need to wake anybody */
+	if (g_ThreadPool->spinning_threads > 0)
+		return true;
+
 	if (worker_try_unpark ()) {
 		//mono_trace (G_LOG_LEVEL_DEBUG, MONO_TRACE_THREADPOOL, "[%p] request worker, unparked", mono_native_thread_id_get ());
 		return true;
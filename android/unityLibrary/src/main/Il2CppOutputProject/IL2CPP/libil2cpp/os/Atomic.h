@@ -91,6 +91,22 @@ namespace os
             return Baselib_atomic_load_32_relaxed(addr);
         }
 
+        static inline uint32_t LoadAcquire(const uint32_t* addr)
+        {
+            return (uint32_t)Baselib_atomic_load_32_acquire((const int32_t*)addr);
+        }
+
+        // FetchOr and FetchAnd return the value *before* the operation.
+        static inline uint32_t FetchOr(uint32_t* location, uint32_t value)
+        {
+            return (uint32_t)Baselib_atomic_fetch_or_32_acq_rel((int32_t*)location, (int32_t)value);
+        }
+
+        static inline uint32_t FetchAnd(uint32_t* location, uint32_t value)
+        {
+            return (uint32_t)Baselib_atomic_fetch_and_32_acq_rel((int32_t*)location, (int32_t)value);
+        }
+
         template<typename T>
         static inline T* LoadPointerRelaxed(const T* const * addr)
         {
@@ -233,6 +233,22 @@ namespace os
     {
         return true;
     }
+
+    // Views are copies in heap memory here, so there is nothing to read ahead or lock
+
+    void MemoryMappedFile::AdviseWillNeed(void* address, int64_t length)
+    {
+    }
+
+    bool MemoryMappedFile::LockResident(void* address, int64_t length)
+    {
+        return false;
+    }
+
+    bool MemoryMappedFile::GetResidentPageCount(void* address, int64_t length, int64_t* residentPages, int64_t* totalPages)
+    {
+        return false;
+    }
 }
 }
 #endif
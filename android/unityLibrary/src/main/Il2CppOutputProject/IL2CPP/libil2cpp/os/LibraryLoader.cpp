@@ -1,4 +1,7 @@
 #include "LibraryLoader.h"
+#include "utils/HashUtils.h"
+#include "utils/Il2CppHashMap.h"
+#include "utils/Memory.h"
 #include "utils/StringUtils.h"
 #include "utils/Exception.h"
 
@@ -10,10 +13,93 @@ namespace os
 {
     static Il2CppSetFindPlugInCallback s_FindPluginCallback = NULL;
 
-    typedef std::vector<std::pair<std::basic_string<Il2CppNativeChar>, Baselib_DynamicLibrary_Handle> > DllCacheContainer;
-    typedef DllCacheContainer::const_iterator DllCacheIterator;
+    typedef std::basic_string<Il2CppNativeChar> NativeLibraryName;
+    typedef Il2CppReaderWriterLockedHashMap<NativeLibraryName, Baselib_DynamicLibrary_Handle, utils::StringUtils::StringHasher<NativeLibraryName> > DllCacheContainer;
+    typedef DllCacheContainer::iterator DllCacheIterator;
     static DllCacheContainer s_DllCache; // If a library does not need to be closed - do not add it to the cache.
-    static baselib::ReentrantLock s_DllCacheMutex;
+    static baselib::ReentrantLock s_DllCacheMutex; // Serializes writers of s_DllCache and s_FunctionCache, readers only take the map's shared lock
+
+    // Identifies a resolved P/Invoke. The strings are owned by the cache once an entry is added.
+    struct FunctionCacheKey
+    {
+        const Il2CppNativeChar* moduleName;
+        size_t moduleNameLength;
+        const char* entryPoint;
+        size_t entryPointLength;
+        Il2CppCallConvention callingConvention;
+        Il2CppCharSet charSet;
+        int parameterSize;
+        bool isNoMangle;
+
+        FunctionCacheKey() : moduleName(NULL), moduleNameLength(0), entryPoint(NULL), entryPointLength(0), callingConvention(IL2CPP_CALL_DEFAULT), charSet(CHARSET_NOT_SPECIFIED), parameterSize(0), isNoMangle(false)
+        {
+        }
+
+        FunctionCacheKey(const PInvokeArguments& pinvokeArgs) :
+            moduleName(pinvokeArgs.moduleName.Str()),
+            moduleNameLength(pinvokeArgs.moduleName.Length()),
+            entryPoint(pinvokeArgs.entryPoint.Str()),
+            entryPointLength(pinvokeArgs.entryPoint.Length()),
+            callingConvention(pinvokeArgs.callingConvention),
+            charSet(pinvokeArgs.charSet),
+            parameterSize(pinvokeArgs.parameterSize),
+            isNoMangle(pinvokeArgs.isNoMangle)
+        {
+        }
+    };
+
+    struct FunctionCacheKeyHash
+    {
+        size_t operator()(const FunctionCacheKey& key) const
+        {
+            size_t hash = utils::StringUtils::Hash(key.entryPoint, key.entryPointLength);
+            hash = utils::HashUtils::Combine(hash, utils::StringUtils::Hash(key.moduleName, key.moduleNameLength));
+            return utils::HashUtils::Combine(hash, (size_t)key.charSet);
+        }
+    };
+
+    struct FunctionCacheKeyEquals
+    {
+        bool operator()(const FunctionCacheKey& left, const FunctionCacheKey& right) const
+        {
+            return left.moduleNameLength == right.moduleNameLength &&
+                left.entryPointLength == right.entryPointLength &&
+                left.callingConvention == right.callingConvention &&
+                left.charSet == right.charSet &&
+                left.parameterSize == right.parameterSize &&
+                left.isNoMangle == right.isNoMangle &&
+                memcmp(left.entryPoint, right.entryPoint, left.entryPointLength * sizeof(char)) == 0 &&
+                memcmp(left.moduleName, right.moduleName, left.moduleNameLength * sizeof(Il2CppNativeChar)) == 0;
+        }
+    };
+
+    typedef Il2CppReaderWriterLockedHashMap<FunctionCacheKey, Il2CppMethodPointer, FunctionCacheKeyHash, FunctionCacheKeyEquals> FunctionCacheContainer;
+    static FunctionCacheContainer s_FunctionCache;
+
+    template<typename CharType>
+    static const CharType* DuplicateString(const CharType* str, size_t length)
+    {
+        CharType* copy = static_cast<CharType*>(IL2CPP_MALLOC((length + 1) * sizeof(CharType)));
+        memcpy(copy, str, length * sizeof(CharType));
+        copy[length] = 0;
+        return copy;
+    }
+
+    // Must be called with s_DllCacheMutex held
+    static void ClearFunctionCache()
+    {
+        // Lookups only hold the map's shared lock while comparing key strings, so the keys are detached
+        // under its exclusive lock first and freed once no lookup can reach them
+        FunctionCacheContainer::map_type detached;
+        s_FunctionCache.Swap(detached);
+
+        for (FunctionCacheContainer::map_type::iterator it = detached.begin(); it != detached.end(); ++it)
+        {
+            const FunctionCacheKey& key = it->first;
+            IL2CPP_FREE(const_cast<Il2CppNativeChar*>(key.moduleName));
+            IL2CPP_FREE(const_cast<char*>(key.entryPoint));
+        }
+    }
 
     static inline Il2CppNativeChar AsciiToLower(Il2CppNativeChar c)
     {
@@ -99,12 +185,9 @@ namespace os
             libraryName = s_FindPluginCallback(libraryName);
         auto libraryNameLength = utils::StringUtils::StrLen(libraryName);
 
-        {
-            os::FastAutoLock lock(&s_DllCacheMutex);
-            for (DllCacheIterator it = s_DllCache.begin(); it != s_DllCache.end(); it++)
-                if (it->first.compare(0, std::string::npos, libraryName, libraryNameLength) == 0)
-                    return it->second;
-        }
+        Baselib_DynamicLibrary_Handle cachedHandle;
+        if (s_DllCache.TryGet(NativeLibraryName(libraryName, libraryNameLength), &cachedHandle))
+            return cachedHandle;
 
         bool needsClosing = true;
 
@@ -131,7 +214,12 @@ namespace os
         if ((handle != Baselib_DynamicLibrary_Handle_Invalid) && needsClosing)
         {
             os::FastAutoLock lock(&s_DllCacheMutex);
-            s_DllCache.push_back(std::make_pair(libraryName, handle));
+            if (!s_DllCache.Add(NativeLibraryName(libraryName, libraryNameLength), handle))
+            {
+                // Another thread loaded the same library first, drop our extra reference to it
+                Baselib_DynamicLibrary_Close(handle);
+                s_DllCache.TryGet(NativeLibraryName(libraryName, libraryNameLength), &handle);
+            }
         }
 
         return handle;
@@ -218,19 +306,42 @@ namespace os
         return func;
     }
 
+    bool LibraryLoader::TryGetCachedFunctionPointer(const PInvokeArguments& pinvokeArgs, Il2CppMethodPointer* function)
+    {
+        return s_FunctionCache.TryGet(FunctionCacheKey(pinvokeArgs), function);
+    }
+
+    void LibraryLoader::CacheFunctionPointer(const PInvokeArguments& pinvokeArgs, Il2CppMethodPointer function)
+    {
+        os::FastAutoLock lock(&s_DllCacheMutex);
+
+        Il2CppMethodPointer existingFunction;
+        if (s_FunctionCache.TryGet(FunctionCacheKey(pinvokeArgs), &existingFunction))
+            return;
+
+        FunctionCacheKey key(pinvokeArgs);
+        key.moduleName = DuplicateString(key.moduleName, key.moduleNameLength);
+        key.entryPoint = DuplicateString(key.entryPoint, key.entryPointLength);
+        s_FunctionCache.Add(key, function);
+    }
+
     void LibraryLoader::CleanupLoadedLibraries()
     {
+        os::FastAutoLock lock(&s_DllCacheMutex);
+        ClearFunctionCache();
+
         // We assume that presence of the library in s_DllCache is a valid reason to be able to close it
-        for (DllCacheIterator it = s_DllCache.begin(); it != s_DllCache.end(); it++)
+        for (DllCacheIterator it = s_DllCache.UnlockedBegin(); it != s_DllCache.UnlockedEnd(); it++)
         {
             // If libc is a "loaded library", it is a special case, and closing it will cause dlclose
             // on some Posix platforms to return an error (I'm looking at you, iOS 11). This really is
             // not an error, but Baselib_DynamicLibrary_Close will correctly assert when dlclose
             // returns an error. To avoid this assert, let's skip closing libc.
-            if (utils::StringUtils::NativeStringToUtf8(it->first.c_str()) != "libc")
+            const NativeLibraryName& libraryName = it->first;
+            if (utils::StringUtils::NativeStringToUtf8(libraryName.c_str()) != "libc")
                 Baselib_DynamicLibrary_Close(it->second);
         }
-        s_DllCache.clear();
+        s_DllCache.Clear();
     }
 
     bool LibraryLoader::CloseLoadedLibrary(Baselib_DynamicLibrary_Handle handle)
@@ -240,12 +351,16 @@ namespace os
 
         os::FastAutoLock lock(&s_DllCacheMutex);
         // We assume that presence of the library in s_DllCache is a valid reason to be able to close it
-        for (DllCacheIterator it = s_DllCache.begin(); it != s_DllCache.end(); it++)
+        for (DllCacheIterator it = s_DllCache.UnlockedBegin(); it != s_DllCache.UnlockedEnd(); it++)
         {
             if (it->second == handle)
             {
-                Baselib_DynamicLibrary_Close(it->second);
-                s_DllCache.erase(it);
+                // Function pointers resolved from this library are no longer valid
+                ClearFunctionCache();
+
+                NativeLibraryName libraryName = it->first;
+                s_DllCache.Remove(libraryName);
+                Baselib_DynamicLibrary_Close(handle);
                 return true;
             }
         }
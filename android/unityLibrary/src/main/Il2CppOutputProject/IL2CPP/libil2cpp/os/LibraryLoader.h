@@ -40,6 +40,9 @@ namespace os
         static Baselib_DynamicLibrary_Handle LoadDynamicLibrary(const utils::StringView<Il2CppNativeChar> nativeDynamicLibrary, std::string& detailedError);
         static Il2CppMethodPointer GetFunctionPointer(Baselib_DynamicLibrary_Handle handle, const PInvokeArguments& pinvokeArgs, std::string& detailedError);
         static Il2CppMethodPointer GetFunctionPointer(Baselib_DynamicLibrary_Handle handle, const char* functionName, std::string& detailedError);
+        // Cache of resolved P/Invoke entry points, keyed by library, entry point and mangling options
+        static bool TryGetCachedFunctionPointer(const PInvokeArguments& pinvokeArgs, Il2CppMethodPointer* function);
+        static void CacheFunctionPointer(const PInvokeArguments& pinvokeArgs, Il2CppMethodPointer function);
         static void CleanupLoadedLibraries();
         static bool CloseLoadedLibrary(Baselib_DynamicLibrary_Handle handle);
         static void SetFindPluginCallback(Il2CppSetFindPlugInCallback method);
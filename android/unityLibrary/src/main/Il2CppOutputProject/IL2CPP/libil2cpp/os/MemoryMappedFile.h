@@ -62,6 +62,14 @@ namespace os
         static bool Close(FileHandle* file);
         static void ConfigureHandleInheritability(FileHandle* file, bool inheritability);
         static bool OwnsDuplicatedFileHandle(FileHandle* file);
+
+        // Access hints for read-only views. All of them are best effort and operate on the pages covering the range.
+        // AdviseWillNeed starts reading the pages in ahead of the first access.
+        static void AdviseWillNeed(void* address, int64_t length);
+        // LockResident keeps the pages in physical memory until the view is unmapped, it fails when the process is not allowed to.
+        static bool LockResident(void* address, int64_t length);
+        // GetResidentPageCount returns false if residency cannot be queried on this platform.
+        static bool GetResidentPageCount(void* address, int64_t length, int64_t* residentPages, int64_t* totalPages);
     };
 }
 }
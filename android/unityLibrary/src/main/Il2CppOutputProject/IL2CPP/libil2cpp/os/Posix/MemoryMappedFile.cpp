@@ -11,6 +11,7 @@
 #include "FileHandle.h"
 #include <unistd.h>
 #include <fcntl.h>
+#include <vector>
 
 #ifdef DEFFILEMODE
 #define DEFAULT_FILEMODE DEFFILEMODE
@@ -363,6 +364,65 @@ namespace os
     {
         return !file->doesNotOwnFd;
     }
+
+    static void* GetPageRange(void* address, int64_t length, size_t* rangeLength)
+    {
+        uintptr_t start = (uintptr_t)AlignDownToPageSize((int64_t)(uintptr_t)address);
+        *rangeLength = (size_t)AlignUpToPageSize((int64_t)((uintptr_t)address - start) + length);
+        return (void*)start;
+    }
+
+    void MemoryMappedFile::AdviseWillNeed(void* address, int64_t length)
+    {
+#if defined(MADV_WILLNEED)
+        if (address == NULL || length <= 0)
+            return;
+
+        size_t rangeLength;
+        void* start = GetPageRange(address, length, &rangeLength);
+        madvise(start, rangeLength, MADV_WILLNEED);
+#endif
+    }
+
+    bool MemoryMappedFile::LockResident(void* address, int64_t length)
+    {
+        if (address == NULL || length <= 0)
+            return false;
+
+        size_t rangeLength;
+        void* start = GetPageRange(address, length, &rangeLength);
+        return mlock(start, rangeLength) == 0;
+    }
+
+    bool MemoryMappedFile::GetResidentPageCount(void* address, int64_t length, int64_t* residentPages, int64_t* totalPages)
+    {
+#if IL2CPP_TARGET_LINUX || IL2CPP_TARGET_ANDROID || IL2CPP_TARGET_DARWIN
+        if (address == NULL || length <= 0)
+            return false;
+
+        size_t rangeLength;
+        void* start = GetPageRange(address, length, &rangeLength);
+
+        const size_t pageCount = rangeLength / (size_t)GetPageSize();
+#if IL2CPP_TARGET_DARWIN
+        std::vector<char> pages(pageCount);
+#else
+        std::vector<unsigned char> pages(pageCount);
+#endif
+        if (mincore(start, rangeLength, pages.data()) != 0)
+            return false;
+
+        int64_t resident = 0;
+        for (size_t i = 0; i < pageCount; ++i)
+            resident += pages[i] & 1;
+
+        *residentPages = resident;
+        *totalPages = (int64_t)pageCount;
+        return true;
+#else
+        return false;
+#endif
+    }
 }
 }
 #endif
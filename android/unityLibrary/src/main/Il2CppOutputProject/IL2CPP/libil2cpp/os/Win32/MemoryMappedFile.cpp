@@ -355,6 +355,21 @@ namespace os
     {
         return true;
     }
+
+    void MemoryMappedFile::AdviseWillNeed(void* address, int64_t length)
+    {
+        // PrefetchVirtualMemory is not available on every Windows API family we support, the hint is optional
+    }
+
+    bool MemoryMappedFile::LockResident(void* address, int64_t length)
+    {
+        return false;
+    }
+
+    bool MemoryMappedFile::GetResidentPageCount(void* address, int64_t length, int64_t* residentPages, int64_t* totalPages)
+    {
+        return false;
+    }
 }
 }
 #endif
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "utils/Memory.h"
+#include "utils/NonCopyable.h"
+
+#include "Baselib.h"
+#include "Cpp/Atomic.h"
+
+namespace il2cpp
+{
+namespace utils
+{
+/// Insert only hash set of interned pointers that can be searched without taking a lock.
+///
+/// Every entry keeps the hash of its key next to it, so probes only call the comparer when
+/// the hashes match and growing the table never hashes a key again. Callers hash the key once
+/// and pass the hash to both Find and Add.
+///
+/// Writers (Add, Reserve) must be serialized by the caller, which usually already holds a lock
+/// to make find-or-create atomic. Readers may run concurrently with a writer: an entry becomes
+/// visible once its key is published, and a table that was replaced by a larger one stays
+/// allocated until Clear, as readers may still be probing it. Clear must not race with anything.
+///
+    template<typename Key, typename HashFunc, typename CompareFunc>
+    class ConcurrentInternSet : public NonCopyable
+    {
+    public:
+        ConcurrentInternSet() :
+            m_Table(NULL),
+            m_Count(0)
+        {
+        }
+
+        ~ConcurrentInternSet()
+        {
+            Clear();
+        }
+
+        static size_t Hash(const Key& key)
+        {
+            return HashFunc::Hash(key);
+        }
+
+        bool Find(const Key& key, size_t hash, Key* found) const
+        {
+            const Table* table = m_Table.load(baselib::memory_order_acquire);
+            if (table == NULL)
+                return false;
+
+            const size_t mask = table->capacity - 1;
+            for (size_t index = hash & mask;; index = (index + 1) & mask)
+            {
+                const Entry& entry = table->entries[index];
+                Key stored = entry.key.load(baselib::memory_order_acquire);
+                if (stored == NULL)
+                    return false;
+
+                if (entry.hash.load(baselib::memory_order_relaxed) == hash && CompareFunc()(key, stored))
+                {
+                    *found = stored;
+                    return true;
+                }
+            }
+        }
+
+        // The key must not be in the set yet
+        void Add(Key key, size_t hash)
+        {
+            Table* table = m_Table.load(baselib::memory_order_relaxed);
+            if (table == NULL || (m_Count + 1) * 2 > table->capacity)
+                table = Grow(m_Count + 1);
+
+            Insert(table, key, hash);
+            m_Count++;
+        }
+
+        void Reserve(size_t count)
+        {
+            Table* table = m_Table.load(baselib::memory_order_relaxed);
+            if (table == NULL || count * 2 > table->capacity)
+                Grow(count);
+        }
+
+        size_t Count() const
+        {
+            return m_Count;
+        }
+
+        void Clear()
+        {
+            Table* table = m_Table.load(baselib::memory_order_relaxed);
+            while (table != NULL)
+            {
+                Table* retired = table->retired;
+                IL2CPP_FREE(table);
+                table = retired;
+            }
+
+            m_Table.store(NULL, baselib::memory_order_relaxed);
+            m_Count = 0;
+        }
+
+    private:
+        struct Entry
+        {
+            baselib::atomic<size_t> hash;
+            baselib::atomic<Key> key;
+        };
+
+        struct Table
+        {
+            size_t capacity;
+            // The table this one replaced
+            Table* retired;
+            Entry entries[1];
+        };
+
+        static void Insert(Table* table, Key key, size_t hash)
+        {
+            const size_t mask = table->capacity - 1;
+            size_t index = hash & mask;
+            while (table->entries[index].key.load(baselib::memory_order_relaxed) != NULL)
+                index = (index + 1) & mask;
+
+            // The hash has to be in place before a reader can see the key
+            table->entries[index].hash.store(hash, baselib::memory_order_relaxed);
+            table->entries[index].key.store(key, baselib::memory_order_release);
+        }
+
+        Table* Grow(size_t count)
+        {
+            Table* oldTable = m_Table.load(baselib::memory_order_relaxed);
+
+            size_t capacity = oldTable != NULL ? oldTable->capacity * 2 : 64;
+            while (count * 2 > capacity)
+                capacity *= 2;
+
+            // Zeroed memory is a table of empty entries
+            Table* table = (Table*)IL2CPP_MALLOC_ZERO(sizeof(Table) + (capacity - 1) * sizeof(Entry));
+            table->capacity = capacity;
+            table->retired = oldTable;
+
+            if (oldTable != NULL)
+            {
+                for (size_t i = 0; i < oldTable->capacity; i++)
+                {
+                    Key key = oldTable->entries[i].key.load(baselib::memory_order_relaxed);
+                    if (key != NULL)
+                        Insert(table, key, oldTable->entries[i].hash.load(baselib::memory_order_relaxed));
+                }
+            }
+
+            m_Table.store(table, baselib::memory_order_release);
+            return table;
+        }
+
+        baselib::atomic<Table*> m_Table;
+        // Only read and written by writers
+        size_t m_Count;
+    };
+} /* utils */
+} /* il2cpp */
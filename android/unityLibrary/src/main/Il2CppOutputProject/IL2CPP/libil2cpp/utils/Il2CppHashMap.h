@@ -74,6 +74,7 @@ template<class Key, class T,
 class Il2CppReaderWriterLockedHashMap
 {
 public:
+    typedef Il2CppHashMap<Key, T, HashFcn, EqualKey, Alloc> map_type;
     typedef typename Il2CppHashMap<Key, T, HashFcn, EqualKey, Alloc>::key_type key_type;
     typedef typename Il2CppHashMap<Key, T, HashFcn, EqualKey, Alloc>::size_type size_type;
     typedef typename Il2CppHashMap<Key, T, HashFcn, EqualKey, Alloc>::const_iterator const_iterator;
@@ -111,6 +112,14 @@ public:
         hashMap.clear();
     }
 
+    // Exchanges the contents with an unlocked map. Once no reader can see the entries any more the
+    // caller may release what they point to, which iterating and then clearing would not allow
+    void Swap(map_type& other)
+    {
+        il2cpp::os::FastReaderReaderWriterAutoExclusiveLock writerLock(&lock);
+        hashMap.swap(other);
+    }
+
     void Remove(const key_type& key)
     {
         il2cpp::os::FastReaderReaderWriterAutoExclusiveLock readerLock(&lock);
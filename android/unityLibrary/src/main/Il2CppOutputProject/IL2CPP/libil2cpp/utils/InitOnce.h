@@ -9,29 +9,42 @@ namespace il2cpp
 {
 namespace utils
 {
+    // Stores a pointer that InitOnce readers may load without the lock. For init blocks that also
+    // initialize neighbouring values, which must be protected by the same lock.
+    template<typename T>
+    static inline void Publish(T** value, T* initialized)
+    {
+        Baselib_atomic_store_ptr_release((intptr_t*)value, (intptr_t)initialized);
+    }
+
     // Initializes a pointer from NULL to non-NULL exactly once.
     // Uses double checked locking to avoid taking the lock after the pointer has been initialized.
+    // Once the pointer is published, a call is a single acquire load and a branch.
 
     template<typename T, typename InitBlock>
-    static inline T* InitOnce(T** value, baselib::ReentrantLock* lock, InitBlock init)
+    static IL2CPP_NO_INLINE T* InitOnceSlow(T** value, baselib::ReentrantLock* lock, InitBlock init)
     {
-        // Based on double checked locking implementation in https://preshing.com/20130930/double-checked-locking-is-fixed-in-cpp11/
-
+        os::FastAutoLock autoLock(lock);
         T* tmp = (T*)Baselib_atomic_load_ptr_relaxed((intptr_t*)value);
-        Baselib_atomic_thread_fence_acquire();
         if (tmp == nullptr)
         {
-            os::FastAutoLock autoLock(lock);
-            tmp = (T*)Baselib_atomic_load_ptr_relaxed((intptr_t*)value);
-            if (tmp == nullptr)
-            {
-                tmp = init(autoLock);
-                Baselib_atomic_thread_fence_release();
-                Baselib_atomic_store_ptr_relaxed((intptr_t*)value, (intptr_t)tmp);
-            }
+            tmp = init(autoLock);
+            Publish(value, tmp);
         }
 
         return tmp;
     }
+
+    template<typename T, typename InitBlock>
+    static inline T* InitOnce(T** value, baselib::ReentrantLock* lock, InitBlock init)
+    {
+        // Based on double checked locking implementation in https://preshing.com/20130930/double-checked-locking-is-fixed-in-cpp11/
+
+        T* tmp = (T*)Baselib_atomic_load_ptr_acquire((intptr_t*)value);
+        if (tmp != nullptr)
+            return tmp;
+
+        return InitOnceSlow(value, lock, init);
+    }
 }
 }
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "Baselib.h"
+#include "Cpp/Atomic.h"
+
+namespace il2cpp
+{
+namespace utils
+{
+/// Small, fixed size, direct mapped cache of pointer sized key/value pairs.
+///
+/// Lookups never take a lock: every slot is guarded by a sequence counter, a reader
+/// that races with a writer simply sees a miss. Writers that race for the same slot
+/// drop their update instead of waiting. This makes the cache suitable for memoizing
+/// the result of an expensive but deterministic lookup that may happen on any thread.
+///
+/// A key of 0 is reserved to mark empty slots. SlotCount must be a power of two.
+///
+    template<size_t SlotCount>
+    class LockFreeLookupCache
+    {
+        static_assert((SlotCount & (SlotCount - 1)) == 0, "SlotCount must be a power of two");
+
+    public:
+        LockFreeLookupCache()
+        {
+            for (size_t i = 0; i < SlotCount; ++i)
+            {
+                m_Slots[i].sequence = 0;
+                m_Slots[i].key = 0;
+                m_Slots[i].value = 0;
+            }
+        }
+
+        bool TryGet(uintptr_t key, uintptr_t* value) const
+        {
+            const Slot& slot = m_Slots[SlotIndex(key)];
+
+            uint32_t sequence = slot.sequence.load(baselib::memory_order_acquire);
+            if (sequence & 1)
+                return false;
+
+            uintptr_t storedKey = slot.key.load(baselib::memory_order_relaxed);
+            uintptr_t storedValue = slot.value.load(baselib::memory_order_relaxed);
+
+            baselib::atomic_thread_fence(baselib::memory_order_acquire);
+            if (slot.sequence.load(baselib::memory_order_relaxed) != sequence)
+                return false;
+
+            if (storedKey != key || key == 0)
+                return false;
+
+            *value = storedValue;
+            return true;
+        }
+
+        void Set(uintptr_t key, uintptr_t value)
+        {
+            Write(m_Slots[SlotIndex(key)], key, value);
+        }
+
+        void Clear()
+        {
+            for (size_t i = 0; i < SlotCount; ++i)
+                Write(m_Slots[i], 0, 0);
+        }
+
+    private:
+        struct Slot
+        {
+            baselib::atomic<uint32_t> sequence;
+            baselib::atomic<uintptr_t> key;
+            baselib::atomic<uintptr_t> value;
+        };
+
+        static inline size_t SlotIndex(uintptr_t key)
+        {
+            // Fibonacci hashing spreads aligned addresses and small indices evenly over the slots
+            return (size_t)(((uint64_t)key * 0x9E3779B97F4A7C15ULL) >> 32) & (SlotCount - 1);
+        }
+
+        static void Write(Slot& slot, uintptr_t key, uintptr_t value)
+        {
+            uint32_t sequence = slot.sequence.load(baselib::memory_order_relaxed);
+            if (sequence & 1)
+                return;
+
+            if (!slot.sequence.compare_exchange_strong(sequence, sequence + 1, baselib::memory_order_relaxed, baselib::memory_order_relaxed))
+                return;
+
+            baselib::atomic_thread_fence(baselib::memory_order_release);
+            slot.key.store(key, baselib::memory_order_relaxed);
+            slot.value.store(value, baselib::memory_order_relaxed);
+            slot.sequence.store(sequence + 2, baselib::memory_order_release);
+        }
+
+        Slot m_Slots[SlotCount];
+    };
+} /* utils */
+} /* il2cpp */
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "il2cpp-config.h"
+
+namespace il2cpp
+{
+namespace utils
+{
+    // memmove and memset for the short copies array icalls mostly see, where the call into the C runtime
+    // and its size dispatch cost more than the copy. Copies of up to 32 bytes are done with two possibly
+    // overlapping loads from each end of the range, all reads happen before any write, so the source and
+    // destination may overlap. Longer copies go to the C runtime.
+    class MemoryCopy
+    {
+    public:
+        static inline void Move(void* destination, const void* source, size_t size)
+        {
+            uint8_t* dst = static_cast<uint8_t*>(destination);
+            const uint8_t* src = static_cast<const uint8_t*>(source);
+
+            if (size > 32)
+            {
+                memmove(dst, src, size);
+            }
+            else if (size > 16)
+            {
+                MoveEnds<16>(dst, src, size);
+            }
+            else if (size > 8)
+            {
+                MoveEnds<8>(dst, src, size);
+            }
+            else if (size > 4)
+            {
+                MoveEnds<4>(dst, src, size);
+            }
+            else if (size > 2)
+            {
+                MoveEnds<2>(dst, src, size);
+            }
+            else if (size > 0)
+            {
+                MoveEnds<1>(dst, src, size);
+            }
+        }
+
+        static inline void Zero(void* destination, size_t size)
+        {
+            uint8_t* dst = static_cast<uint8_t*>(destination);
+
+            if (size > 32)
+            {
+                memset(dst, 0, size);
+            }
+            else if (size > 16)
+            {
+                ZeroEnds<16>(dst, size);
+            }
+            else if (size > 8)
+            {
+                ZeroEnds<8>(dst, size);
+            }
+            else if (size > 4)
+            {
+                ZeroEnds<4>(dst, size);
+            }
+            else if (size > 2)
+            {
+                ZeroEnds<2>(dst, size);
+            }
+            else if (size > 0)
+            {
+                ZeroEnds<1>(dst, size);
+            }
+        }
+
+    private:
+        // Covers [0, size) with a Width byte block at each end, size is in [Width, 2 * Width]
+        template<size_t Width>
+        static inline void MoveEnds(uint8_t* dst, const uint8_t* src, size_t size)
+        {
+            uint8_t head[Width];
+            uint8_t tail[Width];
+            memcpy(head, src, Width);
+            memcpy(tail, src + size - Width, Width);
+            memcpy(dst, head, Width);
+            memcpy(dst + size - Width, tail, Width);
+        }
+
+        template<size_t Width>
+        static inline void ZeroEnds(uint8_t* dst, size_t size)
+        {
+            memset(dst, 0, Width);
+            memset(dst + size - Width, 0, Width);
+        }
+    };
+} /* namespace utils */
+} /* namespace il2cpp */
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "il2cpp-config.h"
+
+// Baseline vector instruction sets that every supported CPU of the target architecture has,
+// so code guarded by these macros needs no runtime dispatch.
+// SSE2 is part of x86-64, and AdvSIMD (NEON) is part of ARMv8-A.
+
+#if IL2CPP_TARGET_X64 || (IL2CPP_TARGET_X86 && (defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)))
+#define IL2CPP_SIMD_SSE2 1
+#else
+#define IL2CPP_SIMD_SSE2 0
+#endif
+
+#if IL2CPP_TARGET_ARM64
+#define IL2CPP_SIMD_NEON 1
+#else
+#define IL2CPP_SIMD_NEON 0
+#endif
+
+#if IL2CPP_SIMD_SSE2
+#include <emmintrin.h>
+#elif IL2CPP_SIMD_NEON
+#include <arm_neon.h>
+#endif
@@ -3,9 +3,11 @@
 #include "il2cpp-object-internals.h"
 #include "utils/Functional.h"
 #include "utils/Memory.h"
+#include "utils/Simd.h"
 #include "utils/StringUtils.h"
 #include "External/utfcpp/source/utf8.h"
 #include <stdarg.h>
+#include <algorithm>
 
 namespace il2cpp
 {
@@ -95,6 +97,307 @@ namespace utils
         return ret;
     }
 
+    // Returns the number of leading UTF-16 code units below 0x80, narrowing them into destination on the way.
+    // destination may be NULL when only counting.
+    static inline size_t NarrowAsciiPrefix(const Il2CppChar* utf16String, size_t length, char* destination)
+    {
+        size_t i = 0;
+
+#if IL2CPP_SIMD_SSE2
+        const __m128i nonAsciiMask = _mm_set1_epi16((short)0xFF80);
+        const __m128i zero = _mm_setzero_si128();
+        for (; i + 8 <= length; i += 8)
+        {
+            __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(utf16String + i));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(chars, nonAsciiMask), zero)) != 0xFFFF)
+                break;
+
+            if (destination != NULL)
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(destination + i), _mm_packus_epi16(chars, chars));
+        }
+#elif IL2CPP_SIMD_NEON
+        for (; i + 8 <= length; i += 8)
+        {
+            uint16x8_t chars = vld1q_u16(reinterpret_cast<const uint16_t*>(utf16String + i));
+            if (vmaxvq_u16(chars) >= 0x80)
+                break;
+
+            if (destination != NULL)
+                vst1_u8(reinterpret_cast<uint8_t*>(destination + i), vmovn_u16(chars));
+        }
+#endif
+
+        for (; i < length && utf16String[i] < 0x80; ++i)
+        {
+            if (destination != NULL)
+                destination[i] = static_cast<char>(utf16String[i]);
+        }
+
+        return i;
+    }
+
+    // Returns the number of leading bytes below 0x80, widening them into destination on the way.
+    // destination may be NULL when only counting.
+    static inline size_t WidenAsciiPrefix(const char* utf8String, size_t length, Il2CppChar* destination)
+    {
+        size_t i = 0;
+
+#if IL2CPP_SIMD_SSE2
+        const __m128i zero = _mm_setzero_si128();
+        for (; i + 16 <= length; i += 16)
+        {
+            __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(utf8String + i));
+            if (_mm_movemask_epi8(bytes) != 0)
+                break;
+
+            if (destination != NULL)
+            {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), _mm_unpacklo_epi8(bytes, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i + 8), _mm_unpackhi_epi8(bytes, zero));
+            }
+        }
+#elif IL2CPP_SIMD_NEON
+        for (; i + 16 <= length; i += 16)
+        {
+            uint8x16_t bytes = vld1q_u8(reinterpret_cast<const uint8_t*>(utf8String + i));
+            if (vmaxvq_u8(bytes) >= 0x80)
+                break;
+
+            if (destination != NULL)
+            {
+                vst1q_u16(reinterpret_cast<uint16_t*>(destination + i), vmovl_u8(vget_low_u8(bytes)));
+                vst1q_u16(reinterpret_cast<uint16_t*>(destination + i + 8), vmovl_u8(vget_high_u8(bytes)));
+            }
+        }
+#endif
+
+        for (; i < length && static_cast<uint8_t>(utf8String[i]) < 0x80; ++i)
+        {
+            if (destination != NULL)
+                destination[i] = static_cast<Il2CppChar>(utf8String[i]);
+        }
+
+        return i;
+    }
+
+    static inline bool IsLeadSurrogate(Il2CppChar c) { return c >= 0xD800 && c <= 0xDBFF; }
+    static inline bool IsTrailSurrogate(Il2CppChar c) { return c >= 0xDC00 && c <= 0xDFFF; }
+
+    // Decodes one UTF-16 code point starting at utf16String[i] and returns the number of UTF-8 bytes it needs.
+    // Unpaired surrogates are encoded as-is, matching utfcpp's unchecked conversion.
+    static inline size_t DecodeUtf16(const Il2CppChar* utf16String, size_t length, size_t& i, uint32_t& codePoint)
+    {
+        Il2CppChar c = utf16String[i++];
+        if (c < 0x80)
+        {
+            codePoint = c;
+            return 1;
+        }
+
+        if (c < 0x800)
+        {
+            codePoint = c;
+            return 2;
+        }
+
+        if (IsLeadSurrogate(c) && i < length && IsTrailSurrogate(utf16String[i]))
+        {
+            codePoint = 0x10000 + ((static_cast<uint32_t>(c) - 0xD800) << 10) + (utf16String[i++] - 0xDC00);
+            return 4;
+        }
+
+        codePoint = c;
+        return 3;
+    }
+
+    // Decodes one UTF-8 sequence and returns its length in bytes, or 0 if it is not valid UTF-8
+    // (truncated, overlong, surrogate or out of range), matching utf8::is_valid.
+    static inline size_t DecodeUtf8(const uint8_t* utf8String, size_t remaining, uint32_t& codePoint)
+    {
+        uint8_t lead = utf8String[0];
+        size_t sequenceLength;
+        uint32_t minimum;
+
+        if (lead < 0x80)
+        {
+            codePoint = lead;
+            return 1;
+        }
+        else if ((lead & 0xE0) == 0xC0)
+        {
+            sequenceLength = 2;
+            minimum = 0x80;
+            codePoint = lead & 0x1F;
+        }
+        else if ((lead & 0xF0) == 0xE0)
+        {
+            sequenceLength = 3;
+            minimum = 0x800;
+            codePoint = lead & 0x0F;
+        }
+        else if ((lead & 0xF8) == 0xF0)
+        {
+            sequenceLength = 4;
+            minimum = 0x10000;
+            codePoint = lead & 0x07;
+        }
+        else
+        {
+            return 0;
+        }
+
+        if (sequenceLength > remaining)
+            return 0;
+
+        for (size_t i = 1; i < sequenceLength; ++i)
+        {
+            if ((utf8String[i] & 0xC0) != 0x80)
+                return 0;
+            codePoint = (codePoint << 6) | (utf8String[i] & 0x3F);
+        }
+
+        if (codePoint < minimum || codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint <= 0xDFFF))
+            return 0;
+
+        return sequenceLength;
+    }
+
+    size_t StringUtils::GetUtf8LengthOfUtf16(const Il2CppChar* utf16String, size_t length)
+    {
+        size_t i = 0;
+        size_t utf8Length = 0;
+
+        while (i < length)
+        {
+            size_t asciiLength = NarrowAsciiPrefix(utf16String + i, length - i, NULL);
+            utf8Length += asciiLength;
+            i += asciiLength;
+
+            if (i < length)
+            {
+                uint32_t codePoint;
+                utf8Length += DecodeUtf16(utf16String, length, i, codePoint);
+            }
+        }
+
+        return utf8Length;
+    }
+
+    size_t StringUtils::TranscodeUtf16ToUtf8(const Il2CppChar* utf16String, size_t length, char* destination, size_t destinationSize)
+    {
+        size_t i = 0;
+        size_t written = 0;
+
+        while (i < length)
+        {
+            size_t asciiLength = NarrowAsciiPrefix(utf16String + i, std::min(length - i, destinationSize - written), destination + written);
+            i += asciiLength;
+            written += asciiLength;
+
+            if (i == length || written == destinationSize)
+                break;
+
+            size_t codePointStart = i;
+            uint32_t codePoint;
+            size_t utf8Length = DecodeUtf16(utf16String, length, i, codePoint);
+
+            // Never split a code point when the destination is too small
+            if (written + utf8Length > destinationSize)
+            {
+                i = codePointStart;
+                break;
+            }
+
+            uint8_t* out = reinterpret_cast<uint8_t*>(destination + written);
+            switch (utf8Length)
+            {
+                case 2:
+                    out[0] = static_cast<uint8_t>(0xC0 | (codePoint >> 6));
+                    out[1] = static_cast<uint8_t>(0x80 | (codePoint & 0x3F));
+                    break;
+                case 3:
+                    out[0] = static_cast<uint8_t>(0xE0 | (codePoint >> 12));
+                    out[1] = static_cast<uint8_t>(0x80 | ((codePoint >> 6) & 0x3F));
+                    out[2] = static_cast<uint8_t>(0x80 | (codePoint & 0x3F));
+                    break;
+                default:
+                    out[0] = static_cast<uint8_t>(0xF0 | (codePoint >> 18));
+                    out[1] = static_cast<uint8_t>(0x80 | ((codePoint >> 12) & 0x3F));
+                    out[2] = static_cast<uint8_t>(0x80 | ((codePoint >> 6) & 0x3F));
+                    out[3] = static_cast<uint8_t>(0x80 | (codePoint & 0x3F));
+                    break;
+            }
+
+            written += utf8Length;
+        }
+
+        return written;
+    }
+
+    bool StringUtils::GetUtf16LengthOfUtf8(const char* utf8String, size_t length, size_t* utf16Length)
+    {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(utf8String);
+        size_t i = 0;
+        size_t count = 0;
+
+        while (i < length)
+        {
+            size_t asciiLength = WidenAsciiPrefix(utf8String + i, length - i, NULL);
+            i += asciiLength;
+            count += asciiLength;
+
+            if (i == length)
+                break;
+
+            uint32_t codePoint;
+            size_t sequenceLength = DecodeUtf8(bytes + i, length - i, codePoint);
+            if (sequenceLength == 0)
+                return false;
+
+            i += sequenceLength;
+            count += codePoint >= 0x10000 ? 2 : 1;
+        }
+
+        *utf16Length = count;
+        return true;
+    }
+
+    size_t StringUtils::TranscodeUtf8ToUtf16(const char* utf8String, size_t length, Il2CppChar* destination)
+    {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(utf8String);
+        size_t i = 0;
+        size_t written = 0;
+
+        while (i < length)
+        {
+            size_t asciiLength = WidenAsciiPrefix(utf8String + i, length - i, destination + written);
+            i += asciiLength;
+            written += asciiLength;
+
+            if (i == length)
+                break;
+
+            uint32_t codePoint;
+            size_t sequenceLength = DecodeUtf8(bytes + i, length - i, codePoint);
+            if (sequenceLength == 0)
+                break;
+
+            i += sequenceLength;
+            if (codePoint >= 0x10000)
+            {
+                codePoint -= 0x10000;
+                destination[written++] = static_cast<Il2CppChar>(0xD800 + (codePoint >> 10));
+                destination[written++] = static_cast<Il2CppChar>(0xDC00 + (codePoint & 0x3FF));
+            }
+            else
+            {
+                destination[written++] = static_cast<Il2CppChar>(codePoint);
+            }
+        }
+
+        return written;
+    }
+
     std::string StringUtils::Utf16ToUtf8(const Il2CppChar* utf16String)
     {
         return Utf16ToUtf8(utf16String, -1);
@@ -113,8 +416,9 @@ namespace utils
         }
 
         std::string utf8String;
-        utf8String.reserve(length);
-        utf8::unchecked::utf16to8(utf16String, ptr, std::back_inserter(utf8String));
+        utf8String.resize(GetUtf8LengthOfUtf16(utf16String, length));
+        if (!utf8String.empty())
+            TranscodeUtf16ToUtf8(utf16String, length, &utf8String[0], utf8String.size());
 
         return utf8String;
     }
@@ -133,10 +437,11 @@ namespace utils
     {
         UTF16String utf16String;
 
-        if (utf8::is_valid(utf8String, utf8String + length))
+        size_t utf16Length;
+        if (GetUtf16LengthOfUtf8(utf8String, length, &utf16Length) && utf16Length != 0)
         {
-            utf16String.reserve(length);
-            utf8::unchecked::utf8to16(utf8String, utf8String + length, std::back_inserter(utf16String));
+            utf16String.resize(utf16Length);
+            TranscodeUtf8ToUtf16(utf8String, length, &utf16String[0]);
         }
 
         return utf16String;
@@ -46,6 +46,16 @@ namespace utils
         static UTF16String Utf8ToUtf16(const char* utf8String);
         static UTF16String Utf8ToUtf16(const char* utf8String, size_t length);
         static UTF16String Utf8ToUtf16(const std::string& utf8String);
+
+        // Allocation free transcoding into caller provided buffers. Lengths are in code units and
+        // exclude any null terminator; nothing is null terminated by these functions.
+        static size_t GetUtf8LengthOfUtf16(const Il2CppChar* utf16String, size_t length);
+        // Writes at most destinationSize bytes without splitting a code point, returns the number of bytes written
+        static size_t TranscodeUtf16ToUtf8(const Il2CppChar* utf16String, size_t length, char* destination, size_t destinationSize);
+        // Returns false if utf8String is not valid UTF-8
+        static bool GetUtf16LengthOfUtf8(const char* utf8String, size_t length, size_t* utf16Length);
+        // destination must hold the length computed by GetUtf16LengthOfUtf8, returns the number of code units written
+        static size_t TranscodeUtf8ToUtf16(const char* utf8String, size_t length, Il2CppChar* destination);
         static char* StringDuplicate(const char *strSource);
         static Il2CppChar* StringDuplicate(const Il2CppChar* strSource, size_t length);
         static bool EndsWith(const std::string& string, const std::string& suffix);
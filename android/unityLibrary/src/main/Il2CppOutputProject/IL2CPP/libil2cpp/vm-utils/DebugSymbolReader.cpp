@@ -13,6 +13,8 @@
 #include "vm/GlobalMetadata.h"
 #include "vm/Method.h"
 #include "vm/Reflection.h"
+#include "utils/LockFreeLookupCache.h"
+#include <algorithm>
 #include <string>
 
 #if IL2CPP_TARGET_ARM64E
@@ -58,6 +60,10 @@ namespace utils
 
     static Reader s_usym = { 0 };
 
+    // Exceptions are usually logged from the same handful of call sites, so the same return
+    // addresses get symbolicated over and over. Remember the line index each one resolved to.
+    static LockFreeLookupCache<512> s_RecentLineIndices;
+
     const int headerSize = 24;
     const int lineSize = 24;
     const uint32_t magicUsymlite = 0x2D6D7973; // "sym-"
@@ -74,37 +80,26 @@ namespace utils
 #endif
     }
 
-    // Do a binary search to find the line with the given address
-    // This is looking for the line with the closest address without going over (price is right style)
-    static usymliteLine FindLine(uint64_t address)
+    struct LineAddressLess
     {
-        uint32_t head = 0;
-        uint32_t tail = s_usym.header.lineCount - 1;
-
-        while (head < tail)
+        bool operator()(uint64_t address, const usymliteLine& line) const
         {
-            uint32_t mid = (head + tail + 1) / 2;
-            uint64_t midAddr = s_usym.lines[mid].address;
-
-            if (address < midAddr)
-            {
-                tail = mid - 1;
-            }
-            else
-            {
-                head = mid;
-            }
+            return address < line.address;
         }
+    };
 
-        uint64_t foundAddr = s_usym.lines[head].address;
+    // Do a binary search to find the line with the given address
+    // This is looking for the line with the closest address without going over (price is right style)
+    // When several entries share an address, the last one is returned.
+    static uint32_t FindLineIndex(uint64_t address)
+    {
+        const usymliteLine* end = s_usym.lines + s_usym.header.lineCount;
+        const usymliteLine* lineAfterAddress = std::upper_bound(s_usym.lines, end, address, LineAddressLess());
 
-        // Find the last entry with this address
-        while (head + 1 < s_usym.header.lineCount && s_usym.lines[head + 1].address == foundAddr)
-        {
-            head += 1;
-        }
+        if (lineAfterAddress == s_usym.lines)
+            return 0;
 
-        return s_usym.lines[head];
+        return (uint32_t)(lineAfterAddress - s_usym.lines) - 1;
     }
 
     static const char* GetString(uint32_t index)
@@ -253,8 +248,8 @@ namespace utils
         stackFrames->push_back(frameInfo);
     }
 
-    // Gets the line information for the given address
-    static bool GetUsymLine(void* address, usymliteLine& line)
+    // Converts a native instruction pointer to an address relative to the image base, as stored in the usym file
+    static bool GetAdjustedAddress(void* address, uint64_t& adjustedAddress)
     {
         if (s_usym.debugSymbolData == NULL || address == NULL)
         {
@@ -263,7 +258,7 @@ namespace utils
 
         // The instruction pointer points to the next address, so to get the address we came from, we subtract 1.
         // findLine matches the address to the closest address <= the one we give, so it finds the one we need
-        uint64_t adjustedAddress = ((uint64_t)address) - ((uint64_t)os::Image::GetImageBase()) - 1;
+        adjustedAddress = ((uint64_t)address) - ((uint64_t)os::Image::GetImageBase()) - 1;
 
 #if IL2CPP_TARGET_ANDROID
         // We don't seem to need to subtract by one for Android
@@ -281,7 +276,32 @@ namespace utils
             return false;
         }
 
-        line = FindLine(adjustedAddress);
+        return true;
+    }
+
+    static uint32_t FindLineIndexCached(uint64_t adjustedAddress)
+    {
+        // Key with address + 1 so that an address of zero doesn't collide with the empty slot marker
+        uintptr_t key = (uintptr_t)adjustedAddress + 1;
+        uintptr_t lineIndex;
+        if (s_RecentLineIndices.TryGet(key, &lineIndex))
+            return (uint32_t)lineIndex;
+
+        uint32_t foundIndex = FindLineIndex(adjustedAddress);
+        s_RecentLineIndices.Set(key, foundIndex);
+        return foundIndex;
+    }
+
+    // Gets the line information for the given address
+    static bool GetUsymLine(void* address, usymliteLine& line)
+    {
+        uint64_t adjustedAddress;
+        if (!GetAdjustedAddress(address, adjustedAddress))
+        {
+            return false;
+        }
+
+        line = s_usym.lines[FindLineIndexCached(adjustedAddress)];
 
         // End of symbol entries are placed to indicate that we're past the end of a C# function.
         // These EOS entries have their Line and FileName set to 0xFFFFFFFF
@@ -9,6 +9,7 @@
 #include "os/Locale.h"
 #include "os/Path.h"
 #include "utils/Collections.h"
+#include "utils/LockFreeLookupCache.h"
 #include "utils/PathUtils.h"
 #include "utils/MemoryMappedFile.h"
 #include "utils/Runtime.h"
@@ -42,6 +43,9 @@ namespace utils
     typedef il2cpp::utils::collections::ArrayValueMap<Il2CppMethodPointer, MethodDefinitionKey, MethodInfoToMethodPointerConverter> NativeMethodMap;
     static NativeMethodMap s_NativeMethods;
 
+    // Recently symbolicated instruction pointers and the method they resolved to
+    static LockFreeLookupCache<512> s_RecentMethods;
+
     struct NativeSymbolMutator
     {
         void operator()(MethodDefinitionKey* method)
@@ -60,6 +64,7 @@ namespace utils
     void NativeSymbol::RegisterMethods(const std::vector<MethodDefinitionKey>& managedMethods)
     {
         s_NativeMethods.assign(managedMethods);
+        s_RecentMethods.Clear();
 
 #if IL2CPP_MUTATE_METHOD_POINTERS
         NativeSymbolMutator mutator;
@@ -77,7 +82,7 @@ namespace utils
         return false;
     }
 
-    const VmMethod* NativeSymbol::GetMethodFromNativeSymbol(Il2CppMethodPointer nativeMethod)
+    static const VmMethod* FindMethodFromNativeSymbol(Il2CppMethodPointer nativeMethod)
     {
         // Address has to be above our base address
         if ((void*)nativeMethod < il2cpp::os::Image::GetImageBase())
@@ -114,6 +119,21 @@ namespace utils
         return il2cpp::vm::MetadataCache::GetMethodInfoFromMethodHandle(methodAfterNativeMethod->methodHandle);
     }
 
+    const VmMethod* NativeSymbol::GetMethodFromNativeSymbol(Il2CppMethodPointer nativeMethod)
+    {
+        uintptr_t cachedMethod;
+        if (s_RecentMethods.TryGet((uintptr_t)nativeMethod, &cachedMethod))
+            return reinterpret_cast<const VmMethod*>(cachedMethod);
+
+        const VmMethod* method = FindMethodFromNativeSymbol(nativeMethod);
+
+        // Only remember hits: native frames between managed ones are plentiful and would evict them
+        if (method != NULL)
+            s_RecentMethods.Set((uintptr_t)nativeMethod, (uintptr_t)method);
+
+        return method;
+    }
+
     static void GetMethodDebugInfoWithSymbols(const MethodInfo* method, intptr_t methodPointer, int32_t size, Il2CppMethodDebugInfo& methodDebugInfo)
     {
         methodDebugInfo.methodPointer = (Il2CppMethodPointer)methodPointer;
@@ -3,6 +3,7 @@
 #include "vm/AssemblyName.h"
 #include "vm/MetadataCache.h"
 #include "vm/Runtime.h"
+#include "vm/TypeNameCache.h"
 #include "vm-utils/VmStringUtils.h"
 #include "il2cpp-tabledefs.h"
 #include "il2cpp-class-internals.h"
@@ -107,6 +108,7 @@ namespace vm
     void Assembly::Register(const Il2CppAssembly* assembly)
     {
         s_Assemblies.push_back(assembly);
+        TypeNameCache::Clear();
     }
 
     void Assembly::ClearAllAssemblies()
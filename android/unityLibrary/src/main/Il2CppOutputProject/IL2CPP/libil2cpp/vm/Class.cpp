@@ -9,6 +9,7 @@
 #include "metadata/Il2CppTypeCompare.h"
 #include "os/Atomic.h"
 #include "os/Mutex.h"
+#include "os/Time.h"
 #include "utils/Memory.h"
 #include "utils/StringUtils.h"
 #include "vm/Assembly.h"
@@ -1089,11 +1090,23 @@ namespace vm
     }
 
 // passing lock to ensure we have acquired it. We can add asserts later
+    static void SetupMethodsLockedInternal(Il2CppClass *klass, const il2cpp::os::FastAutoLock& lock);
+
     void SetupMethodsLocked(Il2CppClass *klass, const il2cpp::os::FastAutoLock& lock)
     {
         if ((!klass->method_count && !klass->rank) || klass->methods)
             return;
 
+        int64_t startTicks = os::Time::GetTicks100NanosecondsMonotonic();
+
+        SetupMethodsLockedInternal(klass, lock);
+
+        ++il2cpp_runtime_stats.method_table_init_count;
+        il2cpp_runtime_stats.method_table_init_time_usecs += (uint64_t)(os::Time::GetTicks100NanosecondsMonotonic() - startTicks) / 10;
+    }
+
+    static void SetupMethodsLockedInternal(Il2CppClass *klass, const il2cpp::os::FastAutoLock& lock)
+    {
         if (klass->generic_class)
         {
             Class::InitLocked(GenericClass::GetTypeDefinition(klass->generic_class), lock);
@@ -2251,7 +2264,7 @@ namespace vm
         Il2CppType* type = &klass->byval_arg;
         IL2CPP_ASSERT(is_generic_argument(type));
 
-        Il2CppMetadataGenericParameterHandle gparam = type->data.genericParameterHandle;
+        Il2CppMetadataGenericParameterHandle gparam = MetadataCache::GetGenericParameterFromType(type);
 
         Il2CppClass** constraints = GetOrCreateMonoGenericParameterInfo(gparam)->constraints;
 
@@ -2269,7 +2282,7 @@ namespace vm
                 Il2CppType* constraint_type = &constraint->byval_arg;
                 if (is_generic_argument(constraint_type))
                 {
-                    Il2CppMetadataGenericParameterHandle constraint_param = constraint_type->data.genericParameterHandle;
+                    Il2CppMetadataGenericParameterHandle constraint_param = MetadataCache::GetGenericParameterFromType(constraint_type);
                     Il2CppGenericParameterInfo constraint_info = MetadataCache::GetGenericParameterInfo(constraint_param);
                     if ((constraint_info.flags & IL2CPP_GENERIC_PARAMETER_ATTRIBUTE_REFERENCE_TYPE_CONSTRAINT) == 0 &&
                         (constraint_info.flags & IL2CPP_GENERIC_PARAMETER_ATTRIBUTE_NOT_NULLABLE_VALUE_TYPE_CONSTRAINT) == 0)
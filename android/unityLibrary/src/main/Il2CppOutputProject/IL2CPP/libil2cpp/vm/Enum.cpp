@@ -1,16 +1,22 @@
 #include "vm/Enum.h"
 #include "il2cpp-object-internals.h"
 #include "il2cpp-class-internals.h"
+#include "gc/GarbageCollector.h"
 #include "gc/WriteBarrier.h"
 #include "vm/Array.h"
 #include "vm/Class.h"
 #include "vm/Reflection.h"
 #include "vm/GenericClass.h"
 #include "vm/Field.h"
+#include "vm/Object.h"
 #include "vm/String.h"
 #include "vm/Type.h"
+#include "utils/Il2CppHashMap.h"
 #include "utils/MemoryRead.h"
 
+#include <algorithm>
+#include <vector>
+
 namespace il2cpp
 {
 namespace vm
@@ -55,22 +61,39 @@ namespace vm
         }
     }
 
-    bool Enum::GetEnumValuesAndNames(Il2CppClass* enumType, Il2CppArray** values, Il2CppArray** names)
+    // Values sorted in ascending order, with the matching names, built on first use and shared by every
+    // caller. Managed code copies these before handing them out. Lives in fixed GC memory so that the
+    // arrays stay reachable.
+    struct EnumValuesAndNames
     {
-        size_t nvalues = Class::GetNumFields(enumType) ? Class::GetNumFields(enumType) - 1 : 0;
-        bool sorted = true;
+        Il2CppArray* values;
+        Il2CppArray* names;
+    };
+
+    typedef Il2CppReaderWriterLockedHashMap<Il2CppClass*, EnumValuesAndNames*> EnumValuesAndNamesMap;
+    static EnumValuesAndNamesMap s_EnumValuesAndNames;
 
-        gc::WriteBarrier::GenericStore(values, vm::Array::New(il2cpp_defaults.uint64_class, (il2cpp_array_size_t)nvalues));
-        uint64_t field_value, previous_value = 0;
-        gc::WriteBarrier::GenericStore(names, vm::Array::New(il2cpp_defaults.string_class, (il2cpp_array_size_t)nvalues));
+    struct EnumField
+    {
+        uint64_t value;
+        const char* name;
+    };
 
+    static bool EnumFieldValueLess(const EnumField& left, const EnumField& right)
+    {
+        return left.value < right.value;
+    }
+
+    static EnumValuesAndNames* CreateEnumValuesAndNames(Il2CppClass* enumType)
+    {
         if (enumType->generic_class)
             enumType = GenericClass::GetTypeDefinition(enumType->generic_class);
 
+        std::vector<EnumField> fields;
+        fields.reserve(Class::GetNumFields(enumType));
+
         FieldInfo* field;
         void* iter = NULL;
-
-        int j = 0;
         while ((field = Class::GetFields(enumType, &iter)))
         {
             if (strcmp("value__", field->name) == 0)
@@ -79,20 +102,90 @@ namespace vm
             if (Field::IsDeleted(field))
                 continue;
 
-            il2cpp_array_setref(*names, j, il2cpp::vm::String::New(Field::GetName(field)));
+            EnumField enumField = { GetEnumFieldValue(enumType, field), Field::GetName(field) };
+            fields.push_back(enumField);
+        }
+
+        // Stable, so that names sharing a value keep their declaration order
+        std::stable_sort(fields.begin(), fields.end(), EnumFieldValueLess);
+
+        EnumValuesAndNames* valuesAndNames = (EnumValuesAndNames*)gc::GarbageCollector::AllocateFixed(sizeof(EnumValuesAndNames), NULL);
+        gc::WriteBarrier::GenericStore(&valuesAndNames->values, vm::Array::New(il2cpp_defaults.uint64_class, (il2cpp_array_size_t)fields.size()));
+        gc::WriteBarrier::GenericStore(&valuesAndNames->names, vm::Array::New(il2cpp_defaults.string_class, (il2cpp_array_size_t)fields.size()));
+
+        for (size_t i = 0; i < fields.size(); i++)
+        {
+            il2cpp_array_set(valuesAndNames->values, uint64_t, i, fields[i].value);
+            il2cpp_array_setref(valuesAndNames->names, i, il2cpp::vm::String::Intern(il2cpp::vm::String::New(fields[i].name)));
+        }
+
+        return valuesAndNames;
+    }
+
+    bool Enum::GetEnumValuesAndNames(Il2CppClass* enumType, Il2CppArray** values, Il2CppArray** names)
+    {
+        EnumValuesAndNames* valuesAndNames;
+        if (!s_EnumValuesAndNames.TryGet(enumType, &valuesAndNames))
+        {
+            EnumValuesAndNames* newValuesAndNames = CreateEnumValuesAndNames(enumType);
+            if (s_EnumValuesAndNames.Add(enumType, newValuesAndNames))
+            {
+                valuesAndNames = newValuesAndNames;
+            }
+            else
+            {
+                gc::GarbageCollector::FreeFixed(newValuesAndNames);
+                s_EnumValuesAndNames.TryGet(enumType, &valuesAndNames);
+            }
+        }
+
+        gc::WriteBarrier::GenericStore(values, valuesAndNames->values);
+        gc::WriteBarrier::GenericStore(names, valuesAndNames->names);
+
+        // The values are always sorted, so managed code never reorders the shared arrays
+        return true;
+    }
+
+    uint64_t Enum::GetValue(Il2CppObject* enumObject)
+    {
+        const void* data = Object::Unbox(enumObject);
+
+        switch (enumObject->klass->element_class->byval_arg.type)
+        {
+            case IL2CPP_TYPE_I1:
+            case IL2CPP_TYPE_U1:
+            case IL2CPP_TYPE_BOOLEAN:
+                return *(const uint8_t*)data;
+
+            case IL2CPP_TYPE_I2:
+            case IL2CPP_TYPE_U2:
+            case IL2CPP_TYPE_CHAR:
+                return *(const uint16_t*)data;
 
-            field_value = GetEnumFieldValue(enumType, field);
-            il2cpp_array_set(*values, uint64_t, j, field_value);
+            case IL2CPP_TYPE_I4:
+            case IL2CPP_TYPE_U4:
+                return *(const uint32_t*)data;
 
-            if (previous_value > field_value)
-                sorted = false;
+            case IL2CPP_TYPE_I8:
+            case IL2CPP_TYPE_U8:
+                return *(const uint64_t*)data;
 
-            previous_value = field_value;
+            case IL2CPP_TYPE_I:
+            case IL2CPP_TYPE_U:
+                return *(const uintptr_t*)data;
 
-            j++;
+            default:
+                IL2CPP_ASSERT(0 && "Enum::GetValue");
+                return 0;
         }
+    }
+
+    void Enum::ClearCache()
+    {
+        for (EnumValuesAndNamesMap::iterator it = s_EnumValuesAndNames.UnlockedBegin(); it != s_EnumValuesAndNames.UnlockedEnd(); it++)
+            gc::GarbageCollector::FreeFixed(it->second);
 
-        return sorted;
+        s_EnumValuesAndNames.Clear();
     }
 } /* namespace vm */
 } /* namespace il2cpp */
@@ -12,6 +12,12 @@ namespace vm
     public:
         // exported
         static bool GetEnumValuesAndNames(Il2CppClass* enumType, Il2CppArray** values, Il2CppArray** names);
+
+    public:
+        // internal
+        // Underlying value of a boxed enum, zero extended
+        static uint64_t GetValue(Il2CppObject* enumObject);
+        static void ClearCache();
     };
 } /* namespace vm */
 } /* namespace il2cpp */
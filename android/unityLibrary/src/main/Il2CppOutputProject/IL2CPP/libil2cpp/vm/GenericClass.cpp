@@ -153,6 +153,11 @@ namespace vm
         genericInstanceType->fields = fields;
     }
 
+    bool GenericClass::HasSameGenericTypeDefinitionHandle(const Il2CppGenericClass* gclass1, const Il2CppGenericClass* gclass2)
+    {
+        return MetadataCache::GetTypeHandleFromType(gclass1->type) == MetadataCache::GetTypeHandleFromType(gclass2->type);
+    }
+
     Il2CppClass* GenericClass::GetClass(Il2CppGenericClass* gclass, bool throwOnError)
     {
         Il2CppClass* cachedClass = os::Atomic::LoadPointerRelaxed(&gclass->cached_class);
@@ -39,10 +39,15 @@ namespace vm
             IL2CPP_ASSERT(gclass1->type->type == IL2CPP_TYPE_VALUETYPE || gclass1->type->type == IL2CPP_TYPE_CLASS);
             IL2CPP_ASSERT(gclass2->type->type == IL2CPP_TYPE_VALUETYPE || gclass2->type->type == IL2CPP_TYPE_CLASS);
 
-            return gclass1->type->data.typeHandle == gclass2->type->data.typeHandle;
+            // Equal raw values are enough, but different ones may be an index and a handle that is not yet initialized
+            if (gclass1->type->data.typeHandle == gclass2->type->data.typeHandle)
+                return true;
+
+            return HasSameGenericTypeDefinitionHandle(gclass1, gclass2);
         }
 
     private:
+        static bool HasSameGenericTypeDefinitionHandle(const Il2CppGenericClass* gclass1, const Il2CppGenericClass* gclass2);
         static Il2CppClass* CreateClass(Il2CppGenericClass *gclass, bool throwOnError = true);
     };
 } /* namespace vm */
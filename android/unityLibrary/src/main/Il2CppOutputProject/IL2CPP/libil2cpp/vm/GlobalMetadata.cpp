@@ -32,6 +32,7 @@
 #include "utils/Il2CppHashMap.h"
 #include "utils/Il2CppHashSet.h"
 #include "utils/InitOnce.h"
+#include "utils/Logging.h"
 #include "utils/Memory.h"
 #include "utils/StringUtils.h"
 #include "utils/PathUtils.h"
@@ -40,6 +41,7 @@
 #include "vm/ClassInlines.h"
 #include "vm/GenericClass.h"
 #include "vm/MetadataAlloc.h"
+#include "vm/MetadataFileHints.h"
 #include "vm/MetadataLoader.h"
 #include "vm/MetadataLock.h"
 #include "vm/Exception.h"
@@ -73,9 +75,12 @@ static Il2CppClass* GetTypeInfoFromTypeDefinitionIndex(TypeDefinitionIndex index
 static Il2CppClass* FromTypeDefinition(TypeDefinitionIndex index);
 static GenericParameterIndex GetIndexForGenericParameter(Il2CppMetadataGenericParameterHandle handle);
 static Il2CppMetadataGenericParameterHandle GetGenericParameterFromIndexInternal(GenericParameterIndex index);
+static void InitializeTypeNameTable(int64_t metadataSize);
 
 static void* s_GlobalMetadata;
 static const Il2CppGlobalMetadataHeader* s_GlobalMetadataHeader;
+// Type name table section appended to global-metadata.dat, NULL when the file has none
+static const uint8_t* s_TypeNameTable;
 static const Il2CppGenericMethod** s_GenericMethodTable = NULL;
 
 static const MethodInfo** s_MethodInfoDefinitionTable = NULL;
@@ -137,6 +142,15 @@ const MethodInfo* il2cpp::vm::GlobalMetadata::GetMethodInfoFromMethodDefinitionI
         Il2CppClass* typeInfo = GetTypeInfoFromTypeDefinitionIndex(methodDefinition->declaringType);
         il2cpp::vm::Class::SetupMethods(typeInfo);
         const Il2CppTypeDefinition* typeDefinition = reinterpret_cast<const Il2CppTypeDefinition*>(typeInfo->typeMetadataHandle);
+
+        // The whole method table of the type exists now, publish all of it so that its other methods
+        // never reach the lock
+        for (uint16_t i = 0; i < typeInfo->method_count; i++)
+        {
+            if (typeDefinition->methodStart + i != index)
+                utils::Publish(&s_MethodInfoDefinitionTable[typeDefinition->methodStart + i], typeInfo->methods[i]);
+        }
+
         return typeInfo->methods[index - typeDefinition->methodStart];
     });
 }
@@ -230,13 +244,13 @@ static Il2CppString* GetStringLiteralFromIndex(StringLiteralIndex index)
         return s_StringLiteralTable[index];
 
     const Il2CppStringLiteral* stringLiteral = (const Il2CppStringLiteral*)((const char*)s_GlobalMetadata + s_GlobalMetadataHeader->stringLiteralOffset) + index;
-    Il2CppString* newString = il2cpp::vm::String::NewLen((const char*)s_GlobalMetadata + s_GlobalMetadataHeader->stringLiteralDataOffset + stringLiteral->dataIndex, stringLiteral->length);
+    // Literals live for the lifetime of the runtime, so they are allocated frozen, outside of the GC heap.
+    // Neither they nor this table have to be marked by the collector. A string that loses the race below
+    // stays allocated in the frozen segment, which is harmless.
+    Il2CppString* newString = il2cpp::vm::String::NewLenFrozen((const char*)s_GlobalMetadata + s_GlobalMetadataHeader->stringLiteralDataOffset + stringLiteral->dataIndex, stringLiteral->length);
     Il2CppString* prevString = il2cpp::os::Atomic::CompareExchangePointer<Il2CppString>(s_StringLiteralTable + index, newString, NULL);
     if (prevString == NULL)
-    {
-        il2cpp::gc::GarbageCollector::SetWriteBarrier((void**)s_StringLiteralTable + index);
         return newString;
-    }
     return prevString;
 }
 
@@ -257,24 +271,66 @@ void il2cpp::vm::GlobalMetadata::Register(const Il2CppCodeRegistration* const co
 
 typedef void (*Il2CppTypeUpdater)(Il2CppType*);
 
-static void InitializeTypeHandle(Il2CppType* type)
+// The types in the metadata registration start out holding type definition and generic parameter indices.
+// Rather than rewriting all of them to handles during Initialize, which writes to every page of the types
+// table, each one is converted the first time it is read. Copies made before that (byval_arg, inflated
+// types) convert themselves the same way. A value is a handle if it points into the corresponding metadata
+// table, an index is always smaller than any address in the mapped metadata file.
+static inline bool IsTypeDefinitionHandle(const void* value)
 {
-    type->data.typeHandle = il2cpp::vm::GlobalMetadata::GetTypeHandleFromIndex(type->data.__klassIndex);
+    uintptr_t tableStart = reinterpret_cast<uintptr_t>(s_GlobalMetadata) + s_GlobalMetadataHeader->typeDefinitionsOffset;
+    return reinterpret_cast<uintptr_t>(value) - tableStart < static_cast<uintptr_t>(s_GlobalMetadataHeader->typeDefinitionsSize);
 }
 
-static void ClearTypeHandle(Il2CppType* type)
+static inline bool IsGenericParameterHandle(const void* value)
 {
-    type->data.__klassIndex = GetIndexForTypeDefinitionInternal(reinterpret_cast<const Il2CppTypeDefinition*>(type->data.typeHandle));
+    uintptr_t tableStart = reinterpret_cast<uintptr_t>(s_GlobalMetadata) + s_GlobalMetadataHeader->genericParametersOffset;
+    return reinterpret_cast<uintptr_t>(value) - tableStart < static_cast<uintptr_t>(s_GlobalMetadataHeader->genericParametersSize);
 }
 
-static void InitializeGenericParameterHandle(Il2CppType* type)
+// Racing threads compute and store the same handle, so the unsynchronized write is benign
+static Il2CppMetadataTypeHandle GetOrInitializeTypeHandle(const Il2CppType* type) IL2CPP_DISABLE_TSAN
 {
-    type->data.genericParameterHandle = GetGenericParameterFromIndexInternal(type->data.__genericParameterIndex);
+    Il2CppMetadataTypeHandle handle = type->data.typeHandle;
+    if (IsTypeDefinitionHandle(handle))
+        return handle;
+
+    handle = il2cpp::vm::GlobalMetadata::GetTypeHandleFromIndex(type->data.__klassIndex);
+    const_cast<Il2CppType*>(type)->data.typeHandle = handle;
+    return handle;
+}
+
+static Il2CppMetadataGenericParameterHandle GetOrInitializeGenericParameterHandle(const Il2CppType* type) IL2CPP_DISABLE_TSAN
+{
+    Il2CppMetadataGenericParameterHandle handle = type->data.genericParameterHandle;
+    if (IsGenericParameterHandle(handle))
+        return handle;
+
+    handle = GetGenericParameterFromIndexInternal(type->data.__genericParameterIndex);
+    const_cast<Il2CppType*>(type)->data.genericParameterHandle = handle;
+    return handle;
+}
+
+static void ClearTypeHandle(Il2CppType* type)
+{
+    if (IsTypeDefinitionHandle(type->data.typeHandle))
+    {
+        TypeDefinitionIndex index = GetIndexForTypeDefinitionInternal(reinterpret_cast<const Il2CppTypeDefinition*>(type->data.typeHandle));
+        // The index only fills the low half of the slot, clear the handle bits above it so the slot is not
+        // taken for a handle again by GetOrInitializeTypeHandle
+        type->data.dummy = NULL;
+        type->data.__klassIndex = index;
+    }
 }
 
 static void ClearGenericParameterHandle(Il2CppType* type)
 {
-    type->data.__genericParameterIndex = GetIndexForGenericParameter(reinterpret_cast<Il2CppMetadataGenericParameterHandle>(type->data.genericParameterHandle));
+    if (IsGenericParameterHandle(type->data.genericParameterHandle))
+    {
+        GenericParameterIndex index = GetIndexForGenericParameter(reinterpret_cast<Il2CppMetadataGenericParameterHandle>(type->data.genericParameterHandle));
+        type->data.dummy = NULL;
+        type->data.__genericParameterIndex = index;
+    }
 }
 
 static void ProcessIl2CppTypeDefinitions(Il2CppTypeUpdater updateTypeDef, Il2CppTypeUpdater updateGenericParam)
@@ -321,7 +377,8 @@ static void ProcessIl2CppTypeDefinitions(Il2CppTypeUpdater updateTypeDef, Il2Cpp
 
 bool il2cpp::vm::GlobalMetadata::Initialize(int32_t* imagesCount, int32_t* assembliesCount)
 {
-    s_GlobalMetadata = vm::MetadataLoader::LoadMetadataFile("global-metadata.dat");
+    int64_t metadataSize;
+    s_GlobalMetadata = vm::MetadataLoader::LoadMetadataFile("global-metadata.dat", &metadataSize);
     if (!s_GlobalMetadata)
         return false;
 
@@ -330,9 +387,13 @@ bool il2cpp::vm::GlobalMetadata::Initialize(int32_t* imagesCount, int32_t* assem
     IL2CPP_ASSERT(s_GlobalMetadataHeader->version == 31);
     IL2CPP_ASSERT(s_GlobalMetadataHeader->stringLiteralOffset == sizeof(Il2CppGlobalMetadataHeader));
 
+    MetadataFileHints::Apply(s_GlobalMetadata);
+
     s_MetadataImagesCount = *imagesCount = s_GlobalMetadataHeader->imagesSize / sizeof(Il2CppImageDefinition);
     *assembliesCount = s_GlobalMetadataHeader->assembliesSize / sizeof(Il2CppAssemblyDefinition);
 
+    InitializeTypeNameTable(metadataSize);
+
     // Pre-allocate these arrays so we don't need to lock when reading later.
     // These arrays hold the runtime metadata representation for metadata explicitly
     // referenced during conversion. There is a corresponding table of same size
@@ -343,8 +404,6 @@ bool il2cpp::vm::GlobalMetadata::Initialize(int32_t* imagesCount, int32_t* assem
     s_MethodInfoDefinitionTable = (const MethodInfo**)IL2CPP_CALLOC(s_GlobalMetadataHeader->methodsSize / sizeof(Il2CppMethodDefinition), sizeof(MethodInfo*));
     s_GenericMethodTable = (const Il2CppGenericMethod**)IL2CPP_CALLOC(s_Il2CppMetadataRegistration->methodSpecsCount, sizeof(Il2CppGenericMethod*));
 
-    ProcessIl2CppTypeDefinitions(InitializeTypeHandle, InitializeGenericParameterHandle);
-
     return true;
 }
 
@@ -367,6 +426,8 @@ void il2cpp::vm::GlobalMetadata::InitializeAllMethodMetadata()
     }
 }
 
+static void* ResolveRuntimeMetadata(uintptr_t* metadataPointer, uintptr_t metadataValue, bool throwOnError);
+
 // This method can be called from multiple threads, so it does have a data race. However, each
 // thread is reading from the same read-only metadata, so each thread will set the same values.
 // Therefore, we can safely ignore thread sanitizer issues in this method.
@@ -380,6 +441,36 @@ void* il2cpp::vm::GlobalMetadata::InitializeRuntimeMetadata(uintptr_t* metadataP
     if (IsRuntimeMetadataInitialized(metadataValue))
         return (void*)metadataValue;
 
+    il2cpp_runtime_stats.metadata_usage_lazy_count++;
+
+    return ResolveRuntimeMetadata(metadataPointer, metadataValue, throwOnError);
+}
+
+uint32_t il2cpp::vm::GlobalMetadata::GetRuntimeMetadataUsageCount()
+{
+    return static_cast<uint32_t>(s_Il2CppMetadataRegistration->metadataUsagesCount);
+}
+
+bool il2cpp::vm::GlobalMetadata::IsRuntimeMetadataUsageInitialized(uint32_t usageIndex)
+{
+    IL2CPP_ASSERT(usageIndex < s_Il2CppMetadataRegistration->metadataUsagesCount);
+    uintptr_t* metadataPointer = reinterpret_cast<uintptr_t*>(s_Il2CppMetadataRegistration->metadataUsages[usageIndex]);
+    return IsRuntimeMetadataInitialized((uintptr_t)os::Atomic::ReadPtrVal((intptr_t*)metadataPointer));
+}
+
+// Same as InitializeRuntimeMetadata, but does not count as a lazy initialization and never throws
+void il2cpp::vm::GlobalMetadata::PreloadRuntimeMetadataUsage(uint32_t usageIndex) IL2CPP_DISABLE_TSAN
+{
+    IL2CPP_ASSERT(usageIndex < s_Il2CppMetadataRegistration->metadataUsagesCount);
+    uintptr_t* metadataPointer = reinterpret_cast<uintptr_t*>(s_Il2CppMetadataRegistration->metadataUsages[usageIndex]);
+    uintptr_t metadataValue = (uintptr_t)os::Atomic::ReadPtrVal((intptr_t*)metadataPointer);
+
+    if (!IsRuntimeMetadataInitialized(metadataValue))
+        ResolveRuntimeMetadata(metadataPointer, metadataValue, false);
+}
+
+static void* ResolveRuntimeMetadata(uintptr_t* metadataPointer, uintptr_t metadataValue, bool throwOnError) IL2CPP_DISABLE_TSAN
+{
     uint32_t encodedToken = static_cast<uint32_t>(metadataValue);
     Il2CppMetadataUsage usage = GetEncodedIndexType(encodedToken);
     uint32_t decodedIndex = GetDecodedMethodIndex(encodedToken);
@@ -406,7 +497,7 @@ void* il2cpp::vm::GlobalMetadata::InitializeRuntimeMetadata(uintptr_t* metadataP
             break;
         case kIl2CppMetadataUsageFieldRva:
             const Il2CppType* unused;
-            initialized = (void*)GetFieldDefaultValue(GetFieldInfoFromIndex(decodedIndex), &unused);
+            initialized = (void*)il2cpp::vm::GlobalMetadata::GetFieldDefaultValue(GetFieldInfoFromIndex(decodedIndex), &unused);
             {
                 const size_t MappedFieldDataAlignment = 8; // Should match System.Reflection.Metadata.ManagedPEBuilder.MappedFieldDataAlignment
                 IL2CPP_ASSERT(((uintptr_t)initialized % MappedFieldDataAlignment) == 0);
@@ -432,7 +523,8 @@ void* il2cpp::vm::GlobalMetadata::InitializeRuntimeMetadata(uintptr_t* metadataP
 
 void il2cpp::vm::GlobalMetadata::InitializeStringLiteralTable()
 {
-    s_StringLiteralTable = (Il2CppString**)il2cpp::gc::GarbageCollector::AllocateFixed(s_GlobalMetadataHeader->stringLiteralSize / sizeof(Il2CppStringLiteral) * sizeof(Il2CppString*), NULL);
+    // The literals are frozen strings, so this table holds no references to the GC heap and is not a root
+    s_StringLiteralTable = (Il2CppString**)IL2CPP_CALLOC(s_GlobalMetadataHeader->stringLiteralSize / sizeof(Il2CppStringLiteral), sizeof(Il2CppString*));
 }
 
 void il2cpp::vm::GlobalMetadata::InitializeWindowsRuntimeTypeNamesTables(WindowsRuntimeTypeNameToClassMap& windowsRuntimeTypeNameToClassMap, ClassToWindowsRuntimeTypeNameMap& classToWindowsRuntimeTypeNameMap)
@@ -497,8 +589,9 @@ void il2cpp::vm::GlobalMetadata::InitializeGenericMethodTable(Il2CppMethodTableM
 
 static void ClearStringLiteralTable()
 {
-    il2cpp::gc::GarbageCollector::FreeFixed(s_StringLiteralTable);
+    IL2CPP_FREE(s_StringLiteralTable);
     s_StringLiteralTable = NULL;
+    il2cpp::vm::String::FreeFrozenStrings();
 }
 
 static void FreeAndNull(void** pointer)
@@ -670,7 +763,7 @@ Il2CppClass* il2cpp::vm::GlobalMetadata::GetTypeInfoFromHandle(Il2CppMetadataTyp
 
 Il2CppClass* il2cpp::vm::GlobalMetadata::GetTypeInfoFromType(const Il2CppType* type)
 {
-    return GetTypeInfoFromHandle(type->data.typeHandle);
+    return GetTypeInfoFromHandle(GetOrInitializeTypeHandle(type));
 }
 
 const Il2CppType* il2cpp::vm::GlobalMetadata::GetInterfaceFromOffset(const Il2CppClass* klass, TypeInterfaceIndex offset)
@@ -712,7 +805,7 @@ Il2CppMetadataTypeHandle il2cpp::vm::GlobalMetadata::GetTypeHandleFromIndex(Type
 Il2CppMetadataTypeHandle il2cpp::vm::GlobalMetadata::GetTypeHandleFromType(const Il2CppType* type)
 {
     IL2CPP_ASSERT(type->type == IL2CPP_TYPE_CLASS || type->type == IL2CPP_TYPE_VALUETYPE);
-    return type->data.typeHandle;
+    return GetOrInitializeTypeHandle(type);
 }
 
 bool il2cpp::vm::GlobalMetadata::TypeIsNested(Il2CppMetadataTypeHandle handle)
@@ -791,6 +884,137 @@ Il2CppMetadataTypeHandle il2cpp::vm::GlobalMetadata::GetNestedTypes(Il2CppMetada
     return NULL;
 }
 
+static const Il2CppTypeNameTableImage* GetTypeNameTableImages()
+{
+    return reinterpret_cast<const Il2CppTypeNameTableImage*>(s_TypeNameTable + sizeof(uint32_t));
+}
+
+static void InitializeTypeNameTable(int64_t metadataSize)
+{
+    s_TypeNameTable = NULL;
+
+    if (metadataSize < (int64_t)(sizeof(Il2CppGlobalMetadataHeader) + sizeof(Il2CppTypeNameTableFooter)))
+        return;
+
+    // The file size is not necessarily a multiple of 4, so the footer may be unaligned
+    Il2CppTypeNameTableFooter footer;
+    memcpy(&footer, (const char*)s_GlobalMetadata + metadataSize - sizeof(Il2CppTypeNameTableFooter), sizeof(Il2CppTypeNameTableFooter));
+    if (footer.magic != IL2CPP_TYPE_NAME_TABLE_MAGIC)
+        return;
+
+    const uint8_t* section = (const uint8_t*)s_GlobalMetadata + footer.sectionOffset;
+    bool valid = footer.version == IL2CPP_TYPE_NAME_TABLE_VERSION &&
+        footer.sectionOffset >= sizeof(Il2CppGlobalMetadataHeader) && footer.sectionOffset % 4 == 0 && footer.sectionSize >= sizeof(uint32_t) &&
+        (uint64_t)footer.sectionOffset + footer.sectionSize <= (uint64_t)metadataSize - sizeof(Il2CppTypeNameTableFooter);
+
+    if (valid)
+    {
+        uint32_t imageCount = *reinterpret_cast<const uint32_t*>(section);
+        valid = imageCount == (uint32_t)s_MetadataImagesCount && sizeof(uint32_t) + (uint64_t)imageCount * sizeof(Il2CppTypeNameTableImage) <= footer.sectionSize;
+
+        const Il2CppTypeNameTableImage* images = reinterpret_cast<const Il2CppTypeNameTableImage*>(section + sizeof(uint32_t));
+        for (uint32_t i = 0; valid && i < imageCount; i++)
+        {
+            valid = (images[i].bucketCount & (images[i].bucketCount - 1)) == 0 && images[i].bucketsOffset % 4 == 0 &&
+                (uint64_t)images[i].bucketsOffset + (uint64_t)images[i].bucketCount * sizeof(Il2CppTypeNameTableBucket) <= footer.sectionSize;
+        }
+    }
+
+    if (!valid)
+    {
+        il2cpp::utils::Logging::Write("WARNING: Ignoring the type name tables in global-metadata.dat, they are corrupt or have an unknown version");
+        return;
+    }
+
+    s_TypeNameTable = section;
+}
+
+static const Il2CppTypeNameTableImage* GetTypeNameTable(const Il2CppImage* image)
+{
+    if (s_TypeNameTable == NULL)
+        return NULL;
+
+    // Images that were not built from global-metadata.dat have no table
+    uintptr_t imageIndex = (reinterpret_cast<uintptr_t>(GetImageMetadata(image)) - reinterpret_cast<uintptr_t>(s_MetadataImagesTable)) / sizeof(Il2CppImageGlobalMetadata);
+    if (GetImageMetadata(image) == NULL || imageIndex >= static_cast<uintptr_t>(s_MetadataImagesCount))
+        return NULL;
+
+    const Il2CppTypeNameTableImage* table = GetTypeNameTableImages() + imageIndex;
+    return table->bucketCount != 0 ? table : NULL;
+}
+
+static uint32_t HashTypeName(const char* namespaze, const char* name)
+{
+    uint32_t hash = 2166136261u;
+    for (const char* c = namespaze; *c != '\0'; c++)
+        hash = (hash ^ (uint8_t)*c) * 16777619u;
+
+    hash *= 16777619u;
+
+    for (const char* c = name; *c != '\0'; c++)
+        hash = (hash ^ (uint8_t)*c) * 16777619u;
+
+    return hash;
+}
+
+// Compares the name a type is listed under, "Outer/Inner" for nested types, with the first nameLength characters of name
+static bool TypeNameMatches(const Il2CppTypeDefinition* typeDefinition, const char* namespaze, const char* name, size_t nameLength)
+{
+    const char* typeName = GetStringFromIndex(typeDefinition->nameIndex);
+    size_t typeNameLength = strlen(typeName);
+    if (typeNameLength > nameLength || memcmp(name + nameLength - typeNameLength, typeName, typeNameLength) != 0)
+        return false;
+
+    if (typeDefinition->declaringTypeIndex == kTypeIndexInvalid)
+        return typeNameLength == nameLength && strcmp(GetStringFromIndex(typeDefinition->namespaceIndex), namespaze) == 0;
+
+    size_t declaringNameLength = nameLength - typeNameLength;
+    if (declaringNameLength < 2 || name[declaringNameLength - 1] != '/')
+        return false;
+
+    const Il2CppType* declaringType = il2cpp::vm::GlobalMetadata::GetIl2CppTypeFromIndex(typeDefinition->declaringTypeIndex);
+    return TypeNameMatches(reinterpret_cast<const Il2CppTypeDefinition*>(GetOrInitializeTypeHandle(declaringType)), namespaze, name, declaringNameLength - 1);
+}
+
+bool il2cpp::vm::GlobalMetadata::HasTypeNameTable(const Il2CppImage* image)
+{
+    return GetTypeNameTable(image) != NULL;
+}
+
+bool il2cpp::vm::GlobalMetadata::TryGetTypeHandleFromName(const Il2CppImage* image, const char* namespaze, const char* name, Il2CppMetadataTypeHandle* handle)
+{
+    const Il2CppTypeNameTableImage* table = GetTypeNameTable(image);
+    if (table == NULL)
+        return false;
+
+    const Il2CppTypeNameTableBucket* buckets = reinterpret_cast<const Il2CppTypeNameTableBucket*>(s_TypeNameTable + table->bucketsOffset);
+    const uint32_t typeDefinitionCount = s_GlobalMetadataHeader->typeDefinitionsSize / sizeof(Il2CppTypeDefinition);
+    const uint32_t mask = table->bucketCount - 1;
+    const uint32_t hash = HashTypeName(namespaze, name);
+    const size_t nameLength = strlen(name);
+
+    *handle = NULL;
+
+    uint32_t bucket = hash & mask;
+    for (uint32_t probe = 0; probe < table->bucketCount; probe++, bucket = (bucket + 1) & mask)
+    {
+        if (buckets[bucket].typeIndex == kTypeDefinitionIndexInvalid)
+            break;
+
+        if (buckets[bucket].hash != hash || static_cast<uint32_t>(buckets[bucket].typeIndex) >= typeDefinitionCount)
+            continue;
+
+        const Il2CppTypeDefinition* typeDefinition = GetTypeDefinitionForIndex(buckets[bucket].typeIndex);
+        if (TypeNameMatches(typeDefinition, namespaze, name, nameLength))
+        {
+            *handle = reinterpret_cast<Il2CppMetadataTypeHandle>(typeDefinition);
+            break;
+        }
+    }
+
+    return true;
+}
+
 static void InitializeCustomAttributesCaches(void* param)
 {
     s_CustomAttributesCount = 0;
@@ -1185,7 +1409,7 @@ static Il2CppMetadataGenericParameterHandle GetGenericParameterFromIndexInternal
 Il2CppMetadataGenericParameterHandle il2cpp::vm::GlobalMetadata::GetGenericParameterFromType(const Il2CppType* type)
 {
     IL2CPP_ASSERT(type->type == IL2CPP_TYPE_VAR || type->type == IL2CPP_TYPE_MVAR);
-    return type->data.genericParameterHandle;
+    return GetOrInitializeGenericParameterHandle(type);
 }
 
 Il2CppClass* il2cpp::vm::GlobalMetadata::GetContainerDeclaringType(Il2CppMetadataGenericContainerHandle handle)
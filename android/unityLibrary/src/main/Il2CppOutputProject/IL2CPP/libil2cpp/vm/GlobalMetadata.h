@@ -31,6 +31,9 @@ namespace vm
 
         static void InitializeAllMethodMetadata();
         static void* InitializeRuntimeMetadata(uintptr_t* metadataPointer, bool throwOnError);
+        static uint32_t GetRuntimeMetadataUsageCount();
+        static bool IsRuntimeMetadataUsageInitialized(uint32_t usageIndex);
+        static void PreloadRuntimeMetadataUsage(uint32_t usageIndex);
         static void InitializeStringLiteralTable();
         static void InitializeWindowsRuntimeTypeNamesTables(WindowsRuntimeTypeNameToClassMap& windowsRuntimeTypeNameToClassMap, ClassToWindowsRuntimeTypeNameMap& classToWindowsRuntimeTypeNameMap);
         static void InitializeUnresolvedSignatureTable(Il2CppUnresolvedSignatureMap& unresolvedSignatureMap);
@@ -46,6 +49,12 @@ namespace vm
         static const Il2CppAssembly* GetReferencedAssembly(const Il2CppAssembly* assembly, int32_t referencedAssemblyTableIndex, const Il2CppAssembly assembliesTable[], int assembliesCount);
         static Il2CppMetadataTypeHandle GetAssemblyExportedTypeHandle(const Il2CppImage* image, AssemblyExportedTypeIndex index);
 
+        // Lookups in the type name tables appended to global-metadata.dat, see Il2CppTypeNameTableFooter.
+        // TryGetTypeHandleFromName returns false when there is no table for the image, otherwise handle is
+        // set to the type or to NULL when the image has no type of that name.
+        static bool HasTypeNameTable(const Il2CppImage* image);
+        static bool TryGetTypeHandleFromName(const Il2CppImage* image, const char* namespaze, const char* name, Il2CppMetadataTypeHandle* handle);
+
         static Il2CppClass* GetTypeInfoFromType(const Il2CppType* type);
         static Il2CppClass* GetTypeInfoFromTypeDefinitionIndex(TypeDefinitionIndex index);
         static Il2CppClass* GetTypeInfoFromHandle(Il2CppMetadataTypeHandle handle);
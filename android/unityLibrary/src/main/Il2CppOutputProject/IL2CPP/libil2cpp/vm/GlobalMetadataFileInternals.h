@@ -342,3 +342,38 @@ typedef struct Il2CppGlobalMetadataHeader
     int32_t exportedTypeDefinitionsSize;
 } Il2CppGlobalMetadataHeader;
 #pragma pack(pop, p1)
+
+// Optional (namespace, name) -> type lookup tables, appended to global-metadata.dat after the sections
+// listed in Il2CppGlobalMetadataHeader by a post-processing step. The runtime builds the tables itself when
+// the section is missing. The last bytes of the file are an Il2CppTypeNameTableFooter, which locates the
+// section. The section starts with the image count followed by one Il2CppTypeNameTableImage per image, in
+// image definition order.
+//
+// Each image table is an open addressed array of buckets with a power of two count, probed linearly from
+// hash & (bucketCount - 1). The hash is 32 bit FNV-1a over the namespace bytes, a single zero byte and
+// the name bytes. A table holds every type definition and exported type of the image, and nested types
+// use the "Outer/Inner" name under the namespace of the outermost type. Entries are inserted in the order
+// the runtime adds types to its own table, so on duplicate names the first match along the probe sequence
+// is the type the runtime would have found.
+#define IL2CPP_TYPE_NAME_TABLE_MAGIC 0x4C42544E /* "NTBL" */
+#define IL2CPP_TYPE_NAME_TABLE_VERSION 1
+
+typedef struct Il2CppTypeNameTableFooter
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t sectionOffset;
+    uint32_t sectionSize;
+} Il2CppTypeNameTableFooter;
+
+typedef struct Il2CppTypeNameTableImage
+{
+    uint32_t bucketsOffset; // From the start of the section
+    uint32_t bucketCount; // 0 when the image has no table
+} Il2CppTypeNameTableImage;
+
+typedef struct Il2CppTypeNameTableBucket
+{
+    uint32_t hash;
+    TypeDefinitionIndex typeIndex; // kTypeDefinitionIndexInvalid for an empty bucket
+} Il2CppTypeNameTableBucket;
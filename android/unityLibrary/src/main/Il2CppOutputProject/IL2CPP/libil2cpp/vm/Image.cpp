@@ -194,6 +194,10 @@ namespace vm
 
     void Image::InitNestedTypes(const Il2CppImage *image)
     {
+        // Nested types are already part of the precomputed table
+        if (MetadataCache::HasTypeNameTable(image))
+            return;
+
         for (uint32_t index = 0; index < image->typeCount; index++)
         {
             Il2CppMetadataTypeHandle handle = MetadataCache::GetAssemblyTypeHandle(image, index);
@@ -219,6 +223,11 @@ namespace vm
 
     Il2CppClass* Image::ClassFromName(const Il2CppImage* image, const char* namespaze, const char *name)
     {
+        // Images covered by the type name tables in global-metadata.dat never build a table of their own
+        Il2CppMetadataTypeHandle handle;
+        if (MetadataCache::TryGetTypeHandleFromName(image, namespaze, name, &handle))
+            return handle != NULL ? MetadataCache::GetTypeInfoFromHandle(handle) : NULL;
+
         if (!image->nameToClassHashTable)
         {
             os::FastAutoLock lock(&s_ClassFromNameMutex);
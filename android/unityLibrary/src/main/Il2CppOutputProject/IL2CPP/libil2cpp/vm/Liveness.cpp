@@ -1,6 +1,10 @@
 #include "il2cpp-config.h"
 #include "gc/GarbageCollector.h"
+#include "os/Atomic.h"
+#include "os/Environment.h"
+#include "os/Thread.h"
 #include <utils/dynamic_array.h>
+#include "utils/HashUtils.h"
 #include "vm/Array.h"
 #include "vm/Class.h"
 #include "vm/ClassInlines.h"
@@ -11,16 +15,15 @@
 #include "il2cpp-class-internals.h"
 #include "il2cpp-object-internals.h"
 
-#define MARK_OBJ(obj) \
-    do { \
-        (obj)->klass = (Il2CppClass*)(((size_t)(obj)->klass) | (size_t)1); \
-    } while (0)
+#include "Baselib.h"
+#include "Cpp/ConditionVariable.h"
+#include "Cpp/Lock.h"
 
-#define CLEAR_OBJ(obj) \
-    do { \
-        (obj)->klass = (Il2CppClass*)(((size_t)(obj)->klass) & ~(size_t)1); \
-    } while (0)
+#include <algorithm>
+#include <string.h>
 
+// Objects outside of the GC heap sections (frozen string literals, for instance) have no bit in the mark
+// bitmap, they are marked in the low bit of their klass pointer instead and cleared again by Finalize
 #define IS_MARKED(obj) \
     (((size_t)(obj)->klass) & (size_t)1)
 
@@ -31,16 +34,67 @@ namespace il2cpp
 {
 namespace vm
 {
-    /* number of sub elements of an array to process before recursing
-    * we take a depth first approach to use stack space rather than re-allocating
-    * processing array which requires restarting world to ensure allocator lock is not held
-    */
-    const int kArrayElementsPerChunk = 256;
+    // The traversal runs while the world is stopped, so every allocation it makes after AllocateStruct goes
+    // through the reallocate callback, in whole chunks, never through the C runtime or the GC.
+    //
+    // Marks live in a bitmap over the GC heap sections, one bit per kMarkGranule bytes, built by the first
+    // traversal after the world was stopped. Objects are scanned with the reference bitmap of their class,
+    // computed once by Class::GetBitmap. The calling thread and up to kMaxLivenessThreads - 1 helper threads
+    // each drain a private mark stack chunk. A worker whose chunk fills up, or that holds more than it needs
+    // while others are idle, publishes part of its work as a chunk that any idle worker takes over.
+
+    static const int32_t kMaxLivenessThreads = 8;
+    static const uintptr_t kMarkGranule = 8;
+    static const size_t kChunkBytes = 8 * 1024;
+    static const size_t kLayoutCacheSize = 256;
+    // A worker with at least this many pending objects shares half of them when another worker is idle
+    static const size_t kShareThreshold = 64;
+    // Objects passed to the register callback at a time
+    static const size_t kCallbackBatchSize = 64;
+
+    struct ObjectChunk
+    {
+        ObjectChunk* next;
+        // Every chunk allocated for a LivenessState, so they can all be released
+        ObjectChunk* nextAllocated;
+        size_t count;
+        Il2CppObject* objects[(kChunkBytes - 3 * sizeof(void*)) / sizeof(Il2CppObject*)];
+    };
 
-    /* how far we recurse processing array elements before we stop. Prevents stack overflow */
-    const int kMaxTraverseRecursionDepth = 128;
+    static const size_t kChunkCapacity = sizeof(((ObjectChunk*)NULL)->objects) / sizeof(Il2CppObject*);
 
-    struct CustomGrowableBlockArray;
+    struct HeapRange
+    {
+        uintptr_t start;
+        uintptr_t end;
+        uint32_t* marks;
+    };
+
+    // Reference slots of a class in pointer sized words from the start of an object, or of a boxed value
+    // for value types, as reported by Class::GetBitmap
+    struct ClassLayout
+    {
+        Il2CppClass* klass;
+        ClassLayout* nextAllocated;
+        // One past the highest reference slot, 0 when the class has no references
+        size_t slotCount;
+        size_t bits[1];
+    };
+
+    struct LivenessState;
+
+    struct LivenessWorker
+    {
+        LivenessState* state;
+        os::Thread* thread;
+        ObjectChunk* stack;
+        // Newly marked objects that pass the filter, reported once the traversal is complete
+        ObjectChunk* found;
+        // Objects marked in their klass pointer, kept until Finalize
+        ObjectChunk* klassMarked;
+        ClassLayout* layoutCache[kLayoutCacheSize];
+        uint32_t generation;
+    };
 
     struct LivenessState
     {
@@ -48,311 +102,609 @@ namespace vm
         ~LivenessState();
 
         void Finalize();
-        void Reset();
-        void TraverseObjects();
+        void Traverse();
         void FilterObjects();
 
-        static void TraverseGenericObject(Il2CppObject* object, LivenessState* state);
-        static void TraverseObject(Il2CppObject* object, LivenessState* state);
-        static void TraverseGCDescriptor(Il2CppObject* object, LivenessState* state);
-        static bool TraverseObjectInternal(Il2CppObject* object, bool isStruct, Il2CppClass* klass, LivenessState* state);
-        static void TraverseArray(Il2CppArray* array, LivenessState* state);
-        static bool AddProcessObject(Il2CppObject* object, LivenessState* state);
+        void* Allocate(size_t size);
+        void Free(void* memory);
+        ObjectChunk* AcquireChunk();
+        void ReleaseChunks(ObjectChunk* chunks);
+
+        void BuildHeapRanges();
+        void ReleaseHeapRanges();
+        const HeapRange* FindHeapRange(uintptr_t address) const;
+
+        const ClassLayout* GetLayout(LivenessWorker* worker, Il2CppClass* klass);
+        ClassLayout* CreateLayout(Il2CppClass* klass);
+
+        bool TryMark(LivenessWorker* worker, Il2CppObject* object);
+        void Visit(LivenessWorker* worker, Il2CppObject* object);
+        void Push(LivenessWorker* worker, Il2CppObject* object);
+        void Append(LivenessWorker* worker, ObjectChunk** list, Il2CppObject* object);
+        void ShareWork(LivenessWorker* worker);
+        bool TakeWork(LivenessWorker* worker);
+        void Drain(LivenessWorker* worker);
+
+        void ScanObject(LivenessWorker* worker, Il2CppObject* object);
+        void ScanArray(LivenessWorker* worker, Il2CppArray* array);
+        void ScanSlots(LivenessWorker* worker, void* base, const ClassLayout* layout);
+        void ScanValue(LivenessWorker* worker, void* value, Il2CppClass* klass);
+        void ScanFields(LivenessWorker* worker, void* value, Il2CppClass* klass);
+
+        static void WorkerThread(void* arg);
         static bool ShouldProcessValue(Il2CppObject* val, Il2CppClass* filter);
         static bool FieldCanContainReferences(FieldInfo* field);
 
-        static bool ShouldTraverseObjects(size_t index, int32_t recursion_depth)
+        Il2CppClass* filter;
+        void* callback_userdata;
+        Liveness::register_object_callback filter_callback;
+        Liveness::ReallocateArrayCallback reallocateArray;
+
+        LivenessWorker* workers;
+        int32_t workerCount;
+
+        // Guards the chunk pool, the layout table and calls to the reallocate callback
+        baselib::Lock allocationLock;
+        ObjectChunk* freeChunks;
+        ObjectChunk* allocatedChunks;
+        ClassLayout** layouts;
+        size_t layoutCapacity;
+        size_t layoutCount;
+        ClassLayout* allocatedLayouts;
+
+        HeapRange* heapRanges;
+        size_t heapRangeCount;
+        uint32_t* markBits;
+
+        // Guards the shared work list and the traversal state below
+        baselib::Lock workLock;
+        baselib::ConditionVariable workAvailable;
+        baselib::ConditionVariable workersDone;
+        ObjectChunk* sharedWork;
+        int32_t idleWorkers;
+        int32_t busyHelpers;
+        uint32_t generation;
+        bool traversalDone;
+        bool shutdown;
+    };
+
+    LivenessState::LivenessState(Il2CppClass* filter, uint32_t maxCount, Liveness::register_object_callback callback, void*callback_userdata, Liveness::ReallocateArrayCallback reallocateArray) :
+        filter(filter),
+        callback_userdata(callback_userdata),
+        filter_callback(callback),
+        reallocateArray(reallocateArray),
+        workers(NULL),
+        workerCount(1),
+        freeChunks(NULL),
+        allocatedChunks(NULL),
+        layouts(NULL),
+        layoutCapacity(0),
+        layoutCount(0),
+        allocatedLayouts(NULL),
+        heapRanges(NULL),
+        heapRangeCount(0),
+        markBits(NULL),
+        workAvailable(workLock),
+        workersDone(workLock),
+        sharedWork(NULL),
+        idleWorkers(0),
+        busyHelpers(0),
+        generation(0),
+        traversalDone(false),
+        shutdown(false)
+    {
+        // Helper threads are started here, while the world is still running, as creating a thread may
+        // need locks that a stopped thread holds
+        const int32_t maxWorkers = std::max(1, std::min(os::Environment::GetProcessorCount(), kMaxLivenessThreads));
+
+        workers = new LivenessWorker[maxWorkers];
+        memset(workers, 0, sizeof(LivenessWorker) * maxWorkers);
+        workers[0].state = this;
+
+        for (int32_t i = 1; i < maxWorkers; i++)
         {
-            // Add kArrayElementsPerChunk objects at a time and then traverse
-            return ((index + 1) & (kArrayElementsPerChunk - 1)) == 0 && recursion_depth < kMaxTraverseRecursionDepth;
+            LivenessWorker* worker = &workers[workerCount];
+            worker->state = this;
+            worker->thread = new os::Thread();
+            if (worker->thread->Run(WorkerThread, worker) != os::kErrorCodeSuccess)
+            {
+                delete worker->thread;
+                worker->thread = NULL;
+                break;
+            }
+
+            workerCount++;
         }
+    }
 
-        CustomGrowableBlockArray* all_objects;
+    LivenessState::~LivenessState()
+    {
+        workLock.Acquire();
+        shutdown = true;
+        workAvailable.NotifyAll();
+        workLock.Release();
 
-        Il2CppClass*          filter;
+        for (int32_t i = 1; i < workerCount; i++)
+        {
+            workers[i].thread->Join();
+            delete workers[i].thread;
+        }
 
-        CustomGrowableBlockArray* process_array;
+        ReleaseHeapRanges();
 
-        void*               callback_userdata;
+        while (allocatedChunks != NULL)
+        {
+            ObjectChunk* chunk = allocatedChunks;
+            allocatedChunks = chunk->nextAllocated;
+            Free(chunk);
+        }
 
-        Liveness::register_object_callback filter_callback;
-        Liveness::ReallocateArrayCallback reallocateArray;
+        while (allocatedLayouts != NULL)
+        {
+            ClassLayout* layout = allocatedLayouts;
+            allocatedLayouts = layout->nextAllocated;
+            Free(layout);
+        }
 
-        int32_t               traverse_depth; // track recursion. Prevent stack overflow by limiting recurion
-    };
+        if (layouts != NULL)
+            Free(layouts);
 
-#define kBlockSize (8 * 1024)
-#define kArrayElementsPerBlock ((kBlockSize - 3 *sizeof (void*)) / sizeof (void*))
+        delete[] workers;
+    }
 
-    struct CustomArrayBlock
+    void* LivenessState::Allocate(size_t size)
     {
-        Il2CppObject** next_item;
-        CustomArrayBlock *prev_block;
-        CustomArrayBlock *next_block;
-        Il2CppObject* p_data[kArrayElementsPerBlock];
-    };
+        return reallocateArray(NULL, size, callback_userdata);
+    }
 
-    struct CustomBlockArrayIterator;
-    struct CustomGrowableBlockArray
+    void LivenessState::Free(void* memory)
     {
-        CustomArrayBlock *first_block;
-        CustomArrayBlock *current_block;
-        CustomBlockArrayIterator *iterator;
+        reallocateArray(memory, 0, callback_userdata);
+    }
 
-        CustomGrowableBlockArray(LivenessState *state);
+    ObjectChunk* LivenessState::AcquireChunk()
+    {
+        allocationLock.Acquire();
 
-        bool IsEmpty();
-        void PushBack(Il2CppObject* value, LivenessState *state);
-        Il2CppObject* PopBack();
-        void ResetIterator();
-        Il2CppObject* Next();
-        void Clear();
-        void Destroy(LivenessState *state);
-    };
+        ObjectChunk* chunk = freeChunks;
+        if (chunk != NULL)
+        {
+            freeChunks = chunk->next;
+        }
+        else
+        {
+            chunk = (ObjectChunk*)Allocate(sizeof(ObjectChunk));
+            chunk->nextAllocated = allocatedChunks;
+            allocatedChunks = chunk;
+        }
 
-    struct CustomBlockArrayIterator
-    {
-        CustomGrowableBlockArray *array;
-        CustomArrayBlock *current_block;
-        Il2CppObject** current_position;
-    };
+        allocationLock.Release();
+
+        chunk->next = NULL;
+        chunk->count = 0;
+        return chunk;
+    }
 
-    CustomGrowableBlockArray::CustomGrowableBlockArray(LivenessState *state)
+    void LivenessState::ReleaseChunks(ObjectChunk* chunks)
     {
-        current_block = (CustomArrayBlock*)state->reallocateArray(NULL, kBlockSize, state->callback_userdata);
-        current_block->prev_block = NULL;
-        current_block->next_block = NULL;
-        current_block->next_item = current_block->p_data;
-        first_block = current_block;
+        if (chunks == NULL)
+            return;
+
+        ObjectChunk* last = chunks;
+        while (last->next != NULL)
+            last = last->next;
 
-        iterator = new CustomBlockArrayIterator();
-        iterator->array = this;
-        iterator->current_block = first_block;
-        iterator->current_position = first_block->p_data;
+        allocationLock.Acquire();
+        last->next = freeChunks;
+        freeChunks = chunks;
+        allocationLock.Release();
     }
 
-    bool CustomGrowableBlockArray::IsEmpty()
+    struct HeapRangeCollector
     {
-        return first_block->next_item == first_block->p_data;
-    }
+        // NULL while counting
+        HeapRange* ranges;
+        size_t count;
+        uintptr_t lastEnd;
+    };
 
-    void CustomGrowableBlockArray::PushBack(Il2CppObject* value, LivenessState *state)
+    // Heap sections are reported one block at a time, adjacent blocks are merged into one range
+    static void CollectHeapRange(void* userData, void* start, void* end)
     {
-        if (current_block->next_item == current_block->p_data + kArrayElementsPerBlock)
+        HeapRangeCollector* collector = static_cast<HeapRangeCollector*>(userData);
+
+        if (collector->count > 0 && (uintptr_t)start == collector->lastEnd)
+        {
+            if (collector->ranges != NULL)
+                collector->ranges[collector->count - 1].end = (uintptr_t)end;
+        }
+        else
         {
-            CustomArrayBlock* new_block = current_block->next_block;
-            if (current_block->next_block == NULL)
+            if (collector->ranges != NULL)
             {
-                new_block = (CustomArrayBlock*)state->reallocateArray(NULL, kBlockSize, state->callback_userdata);
-                new_block->next_block = NULL;
-                new_block->prev_block = current_block;
-                new_block->next_item = new_block->p_data;
-                current_block->next_block = new_block;
+                collector->ranges[collector->count].start = (uintptr_t)start;
+                collector->ranges[collector->count].end = (uintptr_t)end;
+                collector->ranges[collector->count].marks = NULL;
             }
-            current_block = new_block;
+            collector->count++;
         }
-        *current_block->next_item++ = value;
+
+        collector->lastEnd = (uintptr_t)end;
     }
 
-    Il2CppObject* CustomGrowableBlockArray::PopBack()
+    static bool HeapRangeStartsBefore(const HeapRange& left, const HeapRange& right)
     {
-        if (current_block->next_item == current_block->p_data)
+        return left.start < right.start;
+    }
+
+    static size_t MarkWordCount(const HeapRange& range)
+    {
+        return ((range.end - range.start) / kMarkGranule + 31) / 32;
+    }
+
+    // Must be called with the world stopped, which holds the GC lock that walking the heap sections requires
+    void LivenessState::BuildHeapRanges()
+    {
+        if (heapRanges != NULL)
+            return;
+
+        HeapRangeCollector collector = { NULL, 0, 0 };
+        gc::GarbageCollector::ForEachHeapSection(&collector, CollectHeapRange);
+        if (collector.count == 0)
+            return;
+
+        const size_t rangeCount = collector.count;
+        heapRanges = (HeapRange*)Allocate(rangeCount * sizeof(HeapRange));
+        collector.ranges = heapRanges;
+        collector.count = 0;
+        gc::GarbageCollector::ForEachHeapSection(&collector, CollectHeapRange);
+        IL2CPP_ASSERT(collector.count == rangeCount);
+
+        std::sort(heapRanges, heapRanges + rangeCount, HeapRangeStartsBefore);
+
+        size_t markWords = 0;
+        for (size_t i = 0; i < rangeCount; i++)
+            markWords += MarkWordCount(heapRanges[i]);
+
+        markBits = (uint32_t*)Allocate(markWords * sizeof(uint32_t));
+        memset(markBits, 0, markWords * sizeof(uint32_t));
+
+        uint32_t* marks = markBits;
+        for (size_t i = 0; i < rangeCount; i++)
         {
-            if (current_block->prev_block == NULL)
-                return NULL;
-            current_block = current_block->prev_block;
-            current_block->next_item = current_block->p_data + kArrayElementsPerBlock;
+            heapRanges[i].marks = marks;
+            marks += MarkWordCount(heapRanges[i]);
         }
-        return *--current_block->next_item;
+
+        heapRangeCount = rangeCount;
     }
 
-    void CustomGrowableBlockArray::ResetIterator()
+    void LivenessState::ReleaseHeapRanges()
     {
-        iterator->current_block = first_block;
-        iterator->current_position = first_block->p_data;
+        if (markBits != NULL)
+            Free(markBits);
+        if (heapRanges != NULL)
+            Free(heapRanges);
+
+        markBits = NULL;
+        heapRanges = NULL;
+        heapRangeCount = 0;
     }
 
-    Il2CppObject* CustomGrowableBlockArray::Next()
+    const HeapRange* LivenessState::FindHeapRange(uintptr_t address) const
     {
-        if (iterator->current_position != iterator->current_block->next_item)
-            return *iterator->current_position++;
-        if (iterator->current_block->next_block == NULL)
-            return NULL;
-        iterator->current_block = iterator->current_block->next_block;
-        iterator->current_position = iterator->current_block->p_data;
-        if (iterator->current_position == iterator->current_block->next_item)
+        size_t low = 0;
+        size_t high = heapRangeCount;
+        while (low < high)
+        {
+            size_t middle = low + (high - low) / 2;
+            if (heapRanges[middle].start <= address)
+                low = middle + 1;
+            else
+                high = middle;
+        }
+
+        if (low == 0 || address >= heapRanges[low - 1].end)
             return NULL;
-        return *iterator->current_position++;
+
+        return &heapRanges[low - 1];
     }
 
-    void CustomGrowableBlockArray::Clear()
+    const ClassLayout* LivenessState::GetLayout(LivenessWorker* worker, Il2CppClass* klass)
     {
-        CustomArrayBlock *block = first_block;
-        while (block != NULL)
-        {
-            block->next_item = block->p_data;
-            block = block->next_block;
-        }
+        ClassLayout*& cached = worker->layoutCache[utils::HashUtils::AlignedPointerHash(klass) & (kLayoutCacheSize - 1)];
+        if (cached != NULL && cached->klass == klass)
+            return cached;
+
+        cached = CreateLayout(klass);
+        return cached;
     }
 
-    void CustomGrowableBlockArray::Destroy(LivenessState *state)
+    // Finds or computes the layout of klass in the table shared by all workers
+    ClassLayout* LivenessState::CreateLayout(Il2CppClass* klass)
     {
-        CustomArrayBlock *block = first_block;
-        while (block != NULL)
+        allocationLock.Acquire();
+
+        size_t mask = layoutCapacity - 1;
+        size_t index = utils::HashUtils::AlignedPointerHash(klass) & mask;
+        if (layouts != NULL)
         {
-            CustomArrayBlock *data_block = block;
-            block = block->next_block;
-            state->reallocateArray(data_block, 0, state->callback_userdata);
+            for (; layouts[index] != NULL; index = (index + 1) & mask)
+            {
+                if (layouts[index]->klass == klass)
+                {
+                    ClassLayout* existing = layouts[index];
+                    allocationLock.Release();
+                    return existing;
+                }
+            }
         }
-        delete iterator;
-        delete this;
+
+        const size_t bitmapSize = Class::GetBitmapSize(klass);
+        ClassLayout* layout = (ClassLayout*)Allocate(sizeof(ClassLayout) + bitmapSize);
+        memset(layout, 0, sizeof(ClassLayout) + bitmapSize);
+        layout->klass = klass;
+        layout->nextAllocated = allocatedLayouts;
+        allocatedLayouts = layout;
+
+        // Instances and array elements only exist for initialized classes, so this never has to take the
+        // metadata lock, which a stopped thread could hold
+        size_t maxSetBit = 0;
+        Class::GetBitmap(klass, layout->bits, maxSetBit);
+        layout->slotCount = (maxSetBit != 0 || (layout->bits[0] & 1) != 0) ? maxSetBit + 1 : 0;
+
+        if ((layoutCount + 1) * 2 > layoutCapacity)
+        {
+            size_t capacity = layoutCapacity == 0 ? 256 : layoutCapacity * 2;
+            ClassLayout** table = (ClassLayout**)Allocate(capacity * sizeof(ClassLayout*));
+            memset(table, 0, capacity * sizeof(ClassLayout*));
+
+            for (size_t i = 0; i < layoutCapacity; i++)
+            {
+                if (layouts[i] == NULL)
+                    continue;
+
+                size_t slot = utils::HashUtils::AlignedPointerHash(layouts[i]->klass) & (capacity - 1);
+                while (table[slot] != NULL)
+                    slot = (slot + 1) & (capacity - 1);
+                table[slot] = layouts[i];
+            }
+
+            if (layouts != NULL)
+                Free(layouts);
+
+            layouts = table;
+            layoutCapacity = capacity;
+            mask = capacity - 1;
+            index = utils::HashUtils::AlignedPointerHash(klass) & mask;
+            while (layouts[index] != NULL)
+                index = (index + 1) & mask;
+        }
+
+        layouts[index] = layout;
+        layoutCount++;
+
+        allocationLock.Release();
+        return layout;
     }
 
-    LivenessState::LivenessState(Il2CppClass* filter, uint32_t maxCount, Liveness::register_object_callback callback, void*callback_userdata, Liveness::ReallocateArrayCallback reallocateArray) :
-        all_objects(NULL),
-        filter(NULL),
-        process_array(NULL),
-        callback_userdata(NULL),
-        filter_callback(NULL),
-        reallocateArray(reallocateArray),
-        traverse_depth(0)
+    bool LivenessState::TryMark(LivenessWorker* worker, Il2CppObject* object)
     {
-// construct liveness_state;
-// allocate memory for the following structs
-// all_objects: contains a list of all referenced objects to be able to clean the vtable bits after the traversal
-// process_array. array that contains the objcets that should be processed. this should run depth first to reduce memory usage
-// if all_objects run out of space, run through list, add objects that match the filter, clear bit in vtable and then clear the array.
+        const HeapRange* range = FindHeapRange((uintptr_t)object);
+        if (range != NULL)
+        {
+            size_t bit = ((uintptr_t)object - range->start) / kMarkGranule;
+            uint32_t* word = &range->marks[bit / 32];
+            uint32_t mask = (uint32_t)1 << (bit % 32);
+
+            if ((os::Atomic::LoadAcquire(word) & mask) != 0)
+                return false;
+
+            return (os::Atomic::FetchOr(word, mask) & mask) == 0;
+        }
 
-        this->filter = filter;
+        Il2CppClass* klass = object->klass;
+        if (((size_t)klass & (size_t)1) != 0)
+            return false;
 
-        this->callback_userdata = callback_userdata;
-        this->filter_callback = callback;
+        Il2CppClass* marked = (Il2CppClass*)((size_t)klass | (size_t)1);
+        if (os::Atomic::CompareExchangePointer(&object->klass, marked, klass) != klass)
+            return false;
 
-        all_objects = new CustomGrowableBlockArray(this);
-        process_array = new CustomGrowableBlockArray(this);
+        Append(worker, &worker->klassMarked, object);
+        return true;
     }
 
-    LivenessState::~LivenessState()
+    void LivenessState::Append(LivenessWorker* worker, ObjectChunk** list, Il2CppObject* object)
     {
-        all_objects->Destroy(this);
-        process_array->Destroy(this);
+        if (*list == NULL || (*list)->count == kChunkCapacity)
+        {
+            ObjectChunk* chunk = AcquireChunk();
+            chunk->next = *list;
+            *list = chunk;
+        }
+
+        (*list)->objects[(*list)->count++] = object;
     }
 
-    void LivenessState::Finalize()
+    void LivenessState::Push(LivenessWorker* worker, Il2CppObject* object)
     {
-        all_objects->ResetIterator();
-        Il2CppObject* object = all_objects->Next();
-        while (object != NULL)
+        ObjectChunk* stack = worker->stack;
+        if (stack->count == kChunkCapacity)
+        {
+            // Hand the full chunk to whoever runs out of work first and continue with an empty one
+            workLock.Acquire();
+            stack->next = sharedWork;
+            sharedWork = stack;
+            if (idleWorkers > 0)
+                workAvailable.Notify(1);
+            workLock.Release();
+
+            stack = worker->stack = AcquireChunk();
+        }
+        else if (stack->count >= kShareThreshold && os::Atomic::LoadRelaxed(&idleWorkers) > 0)
         {
-            CLEAR_OBJ(object);
-            object = all_objects->Next();
+            ShareWork(worker);
         }
+
+        stack->objects[stack->count++] = object;
     }
 
-    void LivenessState::Reset()
+    void LivenessState::ShareWork(LivenessWorker* worker)
     {
-        process_array->Clear();
+        ObjectChunk* stack = worker->stack;
+        ObjectChunk* shared = AcquireChunk();
+
+        // The oldest half is the part most likely to lead to large unexplored subgraphs
+        size_t half = stack->count / 2;
+        memcpy(shared->objects, stack->objects, half * sizeof(Il2CppObject*));
+        memmove(stack->objects, stack->objects + half, (stack->count - half) * sizeof(Il2CppObject*));
+        shared->count = half;
+        stack->count -= half;
+
+        workLock.Acquire();
+        shared->next = sharedWork;
+        sharedWork = shared;
+        workAvailable.Notify(1);
+        workLock.Release();
     }
 
-    void LivenessState::TraverseObjects()
+    // Waits until there is shared work to take or every worker is idle, returns false in the latter case
+    bool LivenessState::TakeWork(LivenessWorker* worker)
     {
-        Il2CppObject* object = NULL;
+        workLock.Acquire();
+        idleWorkers++;
 
-        traverse_depth++;
-        while (!process_array->IsEmpty())
+        for (;;)
         {
-            object = process_array->PopBack();
-            TraverseGenericObject(object, this);
+            if (sharedWork != NULL)
+            {
+                ObjectChunk* chunk = sharedWork;
+                sharedWork = chunk->next;
+                idleWorkers--;
+                workLock.Release();
+
+                chunk->next = NULL;
+                ReleaseChunks(worker->stack);
+                worker->stack = chunk;
+                return true;
+            }
+
+            if (traversalDone || idleWorkers == workerCount)
+            {
+                traversalDone = true;
+                workAvailable.NotifyAll();
+                workLock.Release();
+                return false;
+            }
+
+            workAvailable.Wait();
         }
-        traverse_depth--;
     }
 
-    void LivenessState::FilterObjects()
+    void LivenessState::Drain(LivenessWorker* worker)
     {
-        Il2CppObject* filtered_objects[64];
-        int32_t num_objects = 0;
+        if (worker->stack == NULL)
+            worker->stack = AcquireChunk();
 
-        Il2CppObject* value = all_objects->Next();
-        while (value)
+        for (;;)
         {
-            Il2CppObject* object = value;
-            if (ShouldProcessValue(object, filter))
-                filtered_objects[num_objects++] = object;
-            if (num_objects == 64)
+            while (worker->stack->count > 0)
             {
-                filter_callback(filtered_objects, 64, callback_userdata);
-                num_objects = 0;
+                Il2CppObject* object = worker->stack->objects[--worker->stack->count];
+                ScanObject(worker, object);
             }
-            value = all_objects->Next();
-        }
 
-        if (num_objects != 0)
-            filter_callback(filtered_objects, num_objects, callback_userdata);
+            if (!TakeWork(worker))
+                break;
+        }
     }
 
-    void LivenessState::TraverseGenericObject(Il2CppObject* object, LivenessState* state)
+    void LivenessState::Visit(LivenessWorker* worker, Il2CppObject* object)
     {
-        IL2CPP_NOT_IMPLEMENTED_NO_ASSERT(LivenessState::TraverseGenericObject, "Use GC bitmap when we have one");
-
-#if IL2CPP_HAS_GC_DESCRIPTORS
-        size_t gc_desc = (size_t)(GET_CLASS(object)->gc_desc);
+        if (object == NULL || IS_MARKED(object) || !TryMark(worker, object))
+            return;
 
-        if (gc_desc & (size_t)1)
-            TraverseGCDescriptor(object, state);
-        else
-#endif
-        if (GET_CLASS(object)->rank)
-            TraverseArray((Il2CppArray*)object, state);
-        else
-            TraverseObject(object, state);
-    }
+        Il2CppClass* klass = GET_CLASS(object);
+        if (ShouldProcessValue(object, filter))
+            Append(worker, &worker->found, object);
 
-    void LivenessState::TraverseObject(Il2CppObject* object, LivenessState* state)
-    {
-        TraverseObjectInternal(object, false, GET_CLASS(object), state);
+        if (klass->has_references)
+            Push(worker, object);
     }
 
-    void LivenessState::TraverseGCDescriptor(Il2CppObject* object, LivenessState* state)
+    void LivenessState::ScanSlots(LivenessWorker* worker, void* base, const ClassLayout* layout)
     {
-#define WORDSIZE ((int)sizeof(size_t)*8)
-        int i = 0;
-        size_t mask = (size_t)(GET_CLASS(object)->gc_desc);
+        Il2CppObject** slots = (Il2CppObject**)base;
+        const size_t kBitsPerWord = sizeof(size_t) * 8;
 
-        IL2CPP_ASSERT(mask & (size_t)1);
-
-        for (i = 0; i < WORDSIZE - 2; i++)
+        for (size_t word = 0; word * kBitsPerWord < layout->slotCount; word++)
         {
-            size_t offset = ((size_t)1 << (WORDSIZE - 1 - i));
-            if (mask & offset)
+            size_t bits = layout->bits[word];
+            while (bits != 0)
             {
-                Il2CppObject* val = *(Il2CppObject**)(((char*)object) + i * sizeof(void*));
-                AddProcessObject(val, state);
+                size_t bit = 0;
+                while ((bits & ((size_t)1 << bit)) == 0)
+                    bit++;
+                bits &= bits - 1;
+
+                Visit(worker, slots[word * kBitsPerWord + bit]);
             }
         }
     }
 
-    bool LivenessState::TraverseObjectInternal(Il2CppObject* object, bool isStruct, Il2CppClass* klass, LivenessState* state)
+    void LivenessState::ScanObject(LivenessWorker* worker, Il2CppObject* object)
     {
-        FieldInfo *field;
-        Il2CppClass *p;
-        bool added_objects = false;
+        Il2CppClass* klass = GET_CLASS(object);
+
+        if (klass->rank)
+            ScanArray(worker, (Il2CppArray*)object);
+        else if (klass->initialized)
+            ScanSlots(worker, object, GetLayout(worker, klass));
+        else
+            ScanFields(worker, object, klass);
+    }
 
-        IL2CPP_ASSERT(object);
+    void LivenessState::ScanArray(LivenessWorker* worker, Il2CppArray* array)
+    {
+        Il2CppClass* elementClass = GET_CLASS(array)->element_class;
+        size_t length = Array::GetLength(array);
 
-        if (!klass->size_inited)
+        if (!Class::IsValuetype(elementClass))
         {
-            IL2CPP_ASSERT(isStruct);
-            return false;
+            for (size_t i = 0; i < length; i++)
+                Visit(worker, il2cpp_array_get(array, Il2CppObject*, i));
+            return;
         }
 
-        // subtract the added offset for the vtable. This is added to the offset even though it is a struct
-        if (isStruct)
-            object--;
+        if (!elementClass->has_references)
+            return;
+
+        size_t elementSize = Class::GetArrayElementSize(elementClass);
+        for (size_t i = 0; i < length; i++)
+            ScanValue(worker, il2cpp_array_addr_with_size(array, (int32_t)elementSize, i), elementClass);
+    }
+
+    // Scans an unboxed value of the value type klass
+    void LivenessState::ScanValue(LivenessWorker* worker, void* value, Il2CppClass* klass)
+    {
+        // Layouts and field offsets include the object header of the boxed value
+        Il2CppObject* boxed = (Il2CppObject*)value - 1;
+
+        if (klass->initialized)
+            ScanSlots(worker, boxed, GetLayout(worker, klass));
+        else if (klass->size_inited)
+            ScanFields(worker, boxed, klass);
+    }
 
-        for (p = klass; p != NULL; p = p->parent)
+    // Reflection based scan for classes that were laid out but never initialized, whose bitmap cannot be
+    // computed without taking the metadata lock
+    void LivenessState::ScanFields(LivenessWorker* worker, void* object, Il2CppClass* klass)
+    {
+        for (Il2CppClass* p = klass; p != NULL; p = p->parent)
         {
             void* iter = NULL;
-            while ((field = Class::GetFields(p, &iter)))
+            while (FieldInfo* field = Class::GetFields(p, &iter))
             {
                 if (field->type->attrs & FIELD_ATTRIBUTE_STATIC)
                     continue;
@@ -362,112 +714,99 @@ namespace vm
 
                 if (Type::IsStruct(field->type))
                 {
-                    char* offseted = (char*)object;
-                    offseted += field->offset;
-                    if (Type::IsGenericInstance(field->type))
-                    {
-                        IL2CPP_ASSERT(field->type->data.generic_class->cached_class);
-                        added_objects |= TraverseObjectInternal((Il2CppObject*)offseted, true, field->type->data.generic_class->cached_class, state);
-                    }
-                    else
-                        added_objects |= TraverseObjectInternal((Il2CppObject*)offseted, true, Type::GetClass(field->type), state);
+                    Il2CppClass* fieldClass = Type::IsGenericInstance(field->type) ? field->type->data.generic_class->cached_class : Type::GetClass(field->type);
+                    IL2CPP_ASSERT(fieldClass);
+                    ScanValue(worker, (char*)object + field->offset, fieldClass);
                     continue;
                 }
 
-                if (field->offset == THREAD_STATIC_FIELD_OFFSET)
-                {
-                    IL2CPP_ASSERT(0);
-                }
-                else
-                {
-                    Il2CppObject* val = NULL;
-                    Field::GetValue(object, field, &val);
-                    added_objects |= AddProcessObject(val, state);
-                }
+                IL2CPP_ASSERT(field->offset != THREAD_STATIC_FIELD_OFFSET);
+                Visit(worker, *(Il2CppObject**)((char*)object + field->offset));
             }
         }
-
-        return added_objects;
     }
 
-    void LivenessState::TraverseArray(Il2CppArray* array, LivenessState* state)
+    void LivenessState::WorkerThread(void* arg)
     {
-        size_t i = 0;
-        bool has_references;
-        Il2CppObject* object = (Il2CppObject*)array;
-        Il2CppClass* element_class;
-        size_t elementClassSize;
-        size_t array_length;
-
-        IL2CPP_ASSERT(object);
+        LivenessWorker* worker = (LivenessWorker*)arg;
+        LivenessState* state = worker->state;
 
-        element_class = GET_CLASS(object)->element_class;
-        has_references = !Class::IsValuetype(element_class);
-        IL2CPP_ASSERT(element_class->size_inited != 0);
-
-        FieldInfo* field;
-        void* iter = NULL;
-        while ((field = Class::GetFields(element_class, &iter)))
+        state->workLock.Acquire();
+        for (;;)
         {
-            has_references |= FieldCanContainReferences(field);
-            if (has_references)
+            while (worker->generation == state->generation && !state->shutdown)
+                state->workAvailable.Wait();
+
+            if (state->shutdown)
                 break;
-        }
 
-        if (!has_references)
-            return;
+            worker->generation = state->generation;
+            state->workLock.Release();
 
-        array_length = Array::GetLength(array);
-        if (element_class->byval_arg.valuetype)
-        {
-            size_t items_processed = 0;
-            elementClassSize = Class::GetArrayElementSize(element_class);
-            for (i = 0; i < array_length; i++)
-            {
-                Il2CppObject* object = (Il2CppObject*)il2cpp_array_addr_with_size(array, (int32_t)elementClassSize, i);
-                if (TraverseObjectInternal(object, 1, element_class, state))
-                    items_processed++;
+            state->Drain(worker);
 
-                // Add 64 objects at a time and then traverse
-                if (ShouldTraverseObjects(items_processed, state->traverse_depth))
-                    state->TraverseObjects();
-            }
+            state->workLock.Acquire();
+            state->busyHelpers--;
+            state->workersDone.NotifyAll();
         }
-        else
+        state->workLock.Release();
+    }
+
+    // Drains the roots pushed on the calling thread's stack together with the helper threads
+    void LivenessState::Traverse()
+    {
+        LivenessWorker* caller = &workers[0];
+
+        workLock.Acquire();
+        traversalDone = false;
+        idleWorkers = 0;
+        busyHelpers = workerCount - 1;
+        generation++;
+        workAvailable.NotifyAll();
+        workLock.Release();
+
+        Drain(caller);
+
+        // Helpers may still be on their way out of Drain
+        workLock.Acquire();
+        while (busyHelpers > 0)
+            workersDone.Wait();
+        workLock.Release();
+    }
+
+    void LivenessState::FilterObjects()
+    {
+        for (int32_t i = 0; i < workerCount; i++)
         {
-            size_t items_processed = 0;
-            for (i = 0; i < array_length; i++)
-            {
-                Il2CppObject* val =  il2cpp_array_get(array, Il2CppObject*, i);
-                if (AddProcessObject(val, state))
-                    items_processed++;
+            ObjectChunk* found = workers[i].found;
+            workers[i].found = NULL;
 
-                // Add 64 objects at a time and then traverse
-                if (ShouldTraverseObjects(items_processed, state->traverse_depth))
-                    state->TraverseObjects();
+            for (ObjectChunk* chunk = found; chunk != NULL; chunk = chunk->next)
+            {
+                for (size_t j = 0; j < chunk->count; j += kCallbackBatchSize)
+                    filter_callback(chunk->objects + j, (int)std::min(kCallbackBatchSize, chunk->count - j), callback_userdata);
             }
+
+            ReleaseChunks(found);
         }
     }
 
-    bool LivenessState::AddProcessObject(Il2CppObject* object, LivenessState* state)
+    void LivenessState::Finalize()
     {
-        if (!object || IS_MARKED(object))
-            return false;
-
-        bool has_references = GET_CLASS(object)->has_references;
-        if (has_references || ShouldProcessValue(object, state->filter))
+        for (int32_t i = 0; i < workerCount; i++)
         {
-            state->all_objects->PushBack(object, state);
-            MARK_OBJ(object);
-        }
-        // Check if klass has further references - if not skip adding
-        if (has_references)
-        {
-            state->process_array->PushBack(object, state);
-            return true;
+            for (ObjectChunk* chunk = workers[i].klassMarked; chunk != NULL; chunk = chunk->next)
+            {
+                for (size_t j = 0; j < chunk->count; j++)
+                    chunk->objects[j]->klass = GET_CLASS(chunk->objects[j]);
+            }
+
+            ReleaseChunks(workers[i].klassMarked);
+            workers[i].klassMarked = NULL;
         }
 
-        return false;
+        // The heap may change as soon as the world is restarted
+        ReleaseHeapRanges();
     }
 
     bool LivenessState::ShouldProcessValue(Il2CppObject* val, Il2CppClass* filter)
@@ -514,11 +853,15 @@ namespace vm
     void Liveness::FromRoot(Il2CppObject* root, void* state)
     {
         LivenessState* liveness_state = (LivenessState*)state;
-        liveness_state->Reset();
+        LivenessWorker* caller = &liveness_state->workers[0];
 
-        liveness_state->process_array->PushBack(root, liveness_state);
+        liveness_state->BuildHeapRanges();
+        if (caller->stack == NULL)
+            caller->stack = liveness_state->AcquireChunk();
 
-        liveness_state->TraverseObjects();
+        // The root itself is scanned but not marked or reported
+        liveness_state->Push(caller, root);
+        liveness_state->Traverse();
 
         //Filter objects and call callback to register found objects
         liveness_state->FilterObjects();
@@ -527,9 +870,12 @@ namespace vm
     void Liveness::FromStatics(void* state)
     {
         LivenessState* liveness_state = (LivenessState*)state;
+        LivenessWorker* caller = &liveness_state->workers[0];
         const il2cpp::utils::dynamic_array<Il2CppClass*>& classesWithStatics = Class::GetStaticFieldData();
 
-        liveness_state->Reset();
+        liveness_state->BuildHeapRanges();
+        if (caller->stack == NULL)
+            caller->stack = liveness_state->AcquireChunk();
 
         for (il2cpp::utils::dynamic_array<Il2CppClass*>::const_iterator iter = classesWithStatics.begin();
              iter != classesWithStatics.end();
@@ -559,11 +905,11 @@ namespace vm
                     if (Type::IsGenericInstance(field->type))
                     {
                         IL2CPP_ASSERT(field->type->data.generic_class->cached_class);
-                        LivenessState::TraverseObjectInternal((Il2CppObject*)offseted, true, field->type->data.generic_class->cached_class, liveness_state);
+                        liveness_state->ScanValue(caller, offseted, field->type->data.generic_class->cached_class);
                     }
                     else
                     {
-                        LivenessState::TraverseObjectInternal((Il2CppObject*)offseted, true, Type::GetClass(field->type), liveness_state);
+                        liveness_state->ScanValue(caller, offseted, Type::GetClass(field->type));
                     }
                 }
                 else
@@ -574,12 +920,12 @@ namespace vm
 
                     if (val)
                     {
-                        LivenessState::AddProcessObject(val, liveness_state);
+                        liveness_state->Visit(caller, val);
                     }
                 }
             }
         }
-        liveness_state->TraverseObjects();
+        liveness_state->Traverse();
         //Filter objects and call callback to register found objects
         liveness_state->FilterObjects();
     }
@@ -4,6 +4,7 @@
 #include "gc/GCHandle.h"
 #include "metadata/ArrayMetadata.h"
 #include "metadata/GenericMetadata.h"
+#include "os/File.h"
 #include "vm/Assembly.h"
 #include "vm/Class.h"
 #include "vm/MetadataCache.h"
@@ -13,8 +14,27 @@
 #include "il2cpp-object-internals.h"
 #include "il2cpp-tabledefs.h"
 
+#include "../external/zlib/zlib.h"
+
+#include <algorithm>
 #include <map>
 #include <limits>
+#include <vector>
+
+// Streamed snapshot layout written by WriteManagedMemorySnapshot, all integers little endian:
+//   uint32_t magic, uint32_t version, uint32_t flags
+//   followed by records, deflated as one zlib stream when flags has IL2CPP_MEMORY_SNAPSHOT_COMPRESS.
+// Every record is a uint32_t kind and a uint64_t payload size followed by the payload:
+//   runtime information: the six uint32_t fields of Il2CppRuntimeInformation in declaration order
+//   type:                uint32_t index, flags, base or element type index, size, uint64_t type info address,
+//                        string name, string assembly name, uint32_t field count, per field uint32_t offset,
+//                        uint32_t type index, uint8_t is static, string name, then uint32_t statics size
+//                        and the static field bytes
+//   heap section:        uint64_t start address followed by the section bytes
+//   gc handles:          uint32_t count followed by that many uint64_t object addresses
+//   end:                 empty, always last
+// Strings are a uint32_t length followed by that many UTF-8 bytes. Type indices refer to the index field
+// of type records, -1 means the type is not part of the snapshot.
 
 namespace il2cpp
 {
@@ -292,6 +312,309 @@ namespace MemoryInformation
         runtimeInfo.allocationGranularity = static_cast<uint32_t>(2 * sizeof(void*));
     }
 
+    static const uint32_t kSnapshotMagic = 0x534D4C49; // "ILMS"
+    static const uint32_t kSnapshotVersion = 1;
+    static const size_t kSnapshotBufferSize = 256 * 1024;
+
+    enum SnapshotRecordKind
+    {
+        kSnapshotRecordRuntimeInformation = 1,
+        kSnapshotRecordType = 2,
+        kSnapshotRecordHeapSection = 3,
+        kSnapshotRecordGCHandles = 4,
+        kSnapshotRecordEnd = 5
+    };
+
+    // Buffers, and optionally deflates, everything written to it before it goes to the file. All memory it
+    // needs is allocated up front, so Write can be used while the world is stopped.
+    class SnapshotWriter
+    {
+    public:
+        SnapshotWriter(os::FileHandle* file, bool compress) :
+            m_File(file),
+            m_Compress(compress),
+            m_Failed(false),
+            m_Buffer(kSnapshotBufferSize),
+            m_Used(0)
+        {
+            memset(&m_Stream, 0, sizeof(m_Stream));
+
+            // The heap is written with the world stopped, the fastest level keeps that pause short
+            if (m_Compress && deflateInit(&m_Stream, Z_BEST_SPEED) != Z_OK)
+                m_Failed = true;
+        }
+
+        ~SnapshotWriter()
+        {
+            if (m_Compress)
+                deflateEnd(&m_Stream);
+        }
+
+        bool Failed() const
+        {
+            return m_Failed;
+        }
+
+        void Write(const void* data, size_t size)
+        {
+            if (m_Failed)
+                return;
+
+            if (m_Compress)
+            {
+                Deflate(static_cast<const uint8_t*>(data), size, Z_NO_FLUSH);
+            }
+            else if (m_Used + size <= m_Buffer.size())
+            {
+                memcpy(m_Buffer.data() + m_Used, data, size);
+                m_Used += size;
+            }
+            else
+            {
+                // Large writes, heap sections mostly, bypass the buffer
+                FlushBuffer();
+                WriteToFile(static_cast<const uint8_t*>(data), size);
+            }
+        }
+
+        void WriteUInt32(uint32_t value)
+        {
+            uint8_t bytes[4];
+            for (int i = 0; i < 4; i++)
+                bytes[i] = static_cast<uint8_t>(value >> (i * 8));
+            Write(bytes, sizeof(bytes));
+        }
+
+        void WriteUInt64(uint64_t value)
+        {
+            uint8_t bytes[8];
+            for (int i = 0; i < 8; i++)
+                bytes[i] = static_cast<uint8_t>(value >> (i * 8));
+            Write(bytes, sizeof(bytes));
+        }
+
+        void WriteRecordHeader(SnapshotRecordKind kind, uint64_t payloadSize)
+        {
+            WriteUInt32(kind);
+            WriteUInt64(payloadSize);
+        }
+
+        bool Finish()
+        {
+            if (m_Compress)
+                Deflate(NULL, 0, Z_FINISH);
+            FlushBuffer();
+            return !m_Failed;
+        }
+
+    private:
+        void Deflate(const uint8_t* data, size_t size, int flush)
+        {
+            // avail_in is 32 bits wide, larger sections are fed in pieces
+            do
+            {
+                uInt piece = static_cast<uInt>(std::min<size_t>(size, 1 << 30));
+                m_Stream.next_in = const_cast<uint8_t*>(data);
+                m_Stream.avail_in = piece;
+                data += piece;
+                size -= piece;
+
+                int status;
+                do
+                {
+                    m_Stream.next_out = m_Buffer.data() + m_Used;
+                    m_Stream.avail_out = static_cast<uInt>(m_Buffer.size() - m_Used);
+                    status = deflate(&m_Stream, size == 0 ? flush : Z_NO_FLUSH);
+                    m_Used = m_Buffer.size() - m_Stream.avail_out;
+
+                    if (status == Z_STREAM_ERROR)
+                    {
+                        m_Failed = true;
+                        return;
+                    }
+
+                    if (m_Used == m_Buffer.size())
+                        FlushBuffer();
+                }
+                while (m_Stream.avail_in > 0 || (flush == Z_FINISH && size == 0 && status != Z_STREAM_END));
+            }
+            while (size > 0 && !m_Failed);
+        }
+
+        void FlushBuffer()
+        {
+            WriteToFile(m_Buffer.data(), m_Used);
+            m_Used = 0;
+        }
+
+        void WriteToFile(const uint8_t* data, size_t size)
+        {
+            while (size > 0 && !m_Failed)
+            {
+                int error = 0;
+                int count = static_cast<int>(std::min<size_t>(size, 1 << 30));
+                int32_t written = os::File::Write(m_File, reinterpret_cast<const char*>(data), count, &error);
+                if (error != 0 || written <= 0)
+                {
+                    m_Failed = true;
+                    return;
+                }
+
+                data += written;
+                size -= written;
+            }
+        }
+
+        os::FileHandle* m_File;
+        bool m_Compress;
+        bool m_Failed;
+        z_stream m_Stream;
+        std::vector<uint8_t> m_Buffer;
+        size_t m_Used;
+    };
+
+    static void AppendUInt32(std::vector<uint8_t>& record, uint32_t value)
+    {
+        for (int i = 0; i < 4; i++)
+            record.push_back(static_cast<uint8_t>(value >> (i * 8)));
+    }
+
+    static void AppendUInt64(std::vector<uint8_t>& record, uint64_t value)
+    {
+        for (int i = 0; i < 8; i++)
+            record.push_back(static_cast<uint8_t>(value >> (i * 8)));
+    }
+
+    static void AppendString(std::vector<uint8_t>& record, const char* str, size_t length)
+    {
+        AppendUInt32(record, static_cast<uint32_t>(length));
+        record.insert(record.end(), str, str + length);
+    }
+
+    static void CollectClassCallback(Il2CppClass* klass, void* context)
+    {
+        static_cast<std::vector<Il2CppClass*>*>(context)->push_back(klass);
+    }
+
+    // A sorted vector rather than a map: type indices are positions in it, found by binary search
+    static inline uint32_t FindTypeIndex(const std::vector<Il2CppClass*>& allTypes, Il2CppClass* klass)
+    {
+        std::vector<Il2CppClass*>::const_iterator it = std::lower_bound(allTypes.begin(), allTypes.end(), klass);
+        if (it == allTypes.end() || *it != klass)
+            return static_cast<uint32_t>(-1);
+
+        return static_cast<uint32_t>(it - allTypes.begin());
+    }
+
+    // Each type is serialized into one reused buffer and written out, nothing is kept per type
+    static void WriteMetadata(SnapshotWriter& writer)
+    {
+        std::vector<Il2CppClass*> allTypes;
+        ReportIL2CppClasses(CollectClassCallback, &allTypes);
+        std::sort(allTypes.begin(), allTypes.end());
+        allTypes.erase(std::unique(allTypes.begin(), allTypes.end()), allTypes.end());
+
+        std::vector<uint8_t> record;
+        for (size_t index = 0; index < allTypes.size() && !writer.Failed(); index++)
+        {
+            Il2CppClass* typeInfo = allTypes[index];
+            uint32_t flags;
+            uint32_t baseOrElementTypeIndex;
+
+            if (typeInfo->rank > 0)
+            {
+                flags = kArray | (kArrayRankMask & (typeInfo->rank << 16));
+                baseOrElementTypeIndex = FindTypeIndex(allTypes, typeInfo->element_class);
+            }
+            else
+            {
+                flags = (typeInfo->byval_arg.valuetype || typeInfo->byval_arg.type == IL2CPP_TYPE_PTR) ? kValueType : kNone;
+                Il2CppClass* baseType = Class::GetParent(typeInfo);
+                baseOrElementTypeIndex = baseType != NULL ? FindTypeIndex(allTypes, baseType) : static_cast<uint32_t>(-1);
+            }
+
+            record.clear();
+            AppendUInt32(record, static_cast<uint32_t>(index));
+            AppendUInt32(record, flags);
+            AppendUInt32(record, baseOrElementTypeIndex);
+            AppendUInt32(record, (typeInfo->byval_arg.valuetype) != 0 ? (typeInfo->instance_size - sizeof(Il2CppObject)) : typeInfo->instance_size);
+            AppendUInt64(record, reinterpret_cast<uint64_t>(typeInfo));
+
+            std::string typeName = Type::GetName(&typeInfo->byval_arg, IL2CPP_TYPE_NAME_FORMAT_IL);
+            AppendString(record, typeName.c_str(), typeName.length());
+            const char* assemblyName = typeInfo->image->assembly->aname.name;
+            AppendString(record, assemblyName, strlen(assemblyName));
+
+            // Same filtering as GatherMetadata, arrays report no fields or statics
+            size_t fieldCountOffset = record.size();
+            uint32_t fieldCount = 0;
+            AppendUInt32(record, 0);
+
+            if (typeInfo->rank == 0)
+            {
+                for (int i = 0; i < typeInfo->field_count; i++)
+                {
+                    FieldInfo* fieldInfo = typeInfo->fields + i;
+                    uint32_t fieldTypeIndex = FindTypeIndex(allTypes, Class::FromIl2CppType(fieldInfo->type));
+                    if (fieldTypeIndex == static_cast<uint32_t>(-1) || (fieldInfo->type->attrs & FIELD_ATTRIBUTE_LITERAL) != 0)
+                        continue;
+
+                    AppendUInt32(record, fieldInfo->offset);
+                    AppendUInt32(record, fieldTypeIndex);
+                    record.push_back((fieldInfo->type->attrs & FIELD_ATTRIBUTE_STATIC) != 0 ? 1 : 0);
+                    AppendString(record, fieldInfo->name, strlen(fieldInfo->name));
+                    fieldCount++;
+                }
+            }
+
+            for (int i = 0; i < 4; i++)
+                record[fieldCountOffset + i] = static_cast<uint8_t>(fieldCount >> (i * 8));
+
+            uint32_t staticsSize = typeInfo->rank == 0 && typeInfo->static_fields != NULL ? typeInfo->static_fields_size : 0;
+            AppendUInt32(record, staticsSize);
+
+            writer.WriteRecordHeader(kSnapshotRecordType, record.size() + staticsSize);
+            writer.Write(record.data(), record.size());
+            writer.Write(typeInfo->static_fields, staticsSize);
+        }
+    }
+
+    static void WriteHeapSection(void* context, void* sectionStart, void* sectionEnd)
+    {
+        SnapshotWriter* writer = static_cast<SnapshotWriter*>(context);
+        size_t sectionSize = static_cast<uint8_t*>(sectionEnd) - static_cast<uint8_t*>(sectionStart);
+
+        writer->WriteRecordHeader(kSnapshotRecordHeapSection, sizeof(uint64_t) + sectionSize);
+        writer->WriteUInt64(reinterpret_cast<uint64_t>(sectionStart));
+        writer->Write(sectionStart, sectionSize);
+    }
+
+    static void WriteRuntimeInformation(SnapshotWriter& writer)
+    {
+        Il2CppRuntimeInformation runtimeInfo;
+        FillRuntimeInformation(runtimeInfo);
+
+        writer.WriteRecordHeader(kSnapshotRecordRuntimeInformation, 6 * sizeof(uint32_t));
+        writer.WriteUInt32(runtimeInfo.pointerSize);
+        writer.WriteUInt32(runtimeInfo.objectHeaderSize);
+        writer.WriteUInt32(runtimeInfo.arrayHeaderSize);
+        writer.WriteUInt32(runtimeInfo.arrayBoundsOffsetInHeader);
+        writer.WriteUInt32(runtimeInfo.arraySizeOffsetInHeader);
+        writer.WriteUInt32(runtimeInfo.allocationGranularity);
+    }
+
+    static void WriteGCHandleTargets(SnapshotWriter& writer)
+    {
+        GCHandleTargetIterationContext gcHandleTargetIterationContext;
+        il2cpp::gc::GCHandle::WalkStrongGCHandleTargets(GCHandleIterationCallback, &gcHandleTargetIterationContext);
+
+        const std::vector<Il2CppObject*>& trackedObjects = gcHandleTargetIterationContext.managedObjects;
+        writer.WriteRecordHeader(kSnapshotRecordGCHandles, sizeof(uint32_t) + trackedObjects.size() * sizeof(uint64_t));
+        writer.WriteUInt32(static_cast<uint32_t>(trackedObjects.size()));
+        for (size_t i = 0; i < trackedObjects.size(); i++)
+            writer.WriteUInt64(reinterpret_cast<uint64_t>(trackedObjects[i]));
+    }
+
     struct il2cpp_heap_chunk
     {
         void* start;
@@ -348,6 +671,43 @@ namespace MemoryInformation
         return snapshot;
     }
 
+    // Unlike CaptureManagedMemorySnapshot nothing is copied: the heap sections go straight from the heap to
+    // the file while the world is stopped, so the capture needs no memory proportional to the heap size.
+    bool WriteManagedMemorySnapshot(const char* path, int32_t flags)
+    {
+        int error = 0;
+        os::FileHandle* file = os::File::Open(path, kFileModeCreate, kFileAccessWrite, kFileShareNone, kFileOptionsNone, &error);
+        if (error != 0)
+            return false;
+
+        bool success;
+        {
+            uint8_t header[12];
+            const uint32_t headerFields[3] = { kSnapshotMagic, kSnapshotVersion, static_cast<uint32_t>(flags & IL2CPP_MEMORY_SNAPSHOT_COMPRESS) };
+            for (int i = 0; i < 12; i++)
+                header[i] = static_cast<uint8_t>(headerFields[i / 4] >> ((i % 4) * 8));
+
+            success = os::File::Write(file, reinterpret_cast<const char*>(header), sizeof(header), &error) == sizeof(header) && error == 0;
+
+            SnapshotWriter writer(file, (flags & IL2CPP_MEMORY_SNAPSHOT_COMPRESS) != 0);
+            WriteRuntimeInformation(writer);
+            WriteMetadata(writer);
+
+            // The world stays stopped while the sections are written, so they cannot change under the writer
+            // and, unlike CaptureManagedHeap, there is no need to retry
+            il2cpp::gc::GarbageCollector::StopWorld();
+            il2cpp::gc::GarbageCollector::ForEachHeapSection(&writer, WriteHeapSection);
+            il2cpp::gc::GarbageCollector::StartWorld();
+
+            WriteGCHandleTargets(writer);
+            writer.WriteRecordHeader(kSnapshotRecordEnd, 0);
+            success = writer.Finish() && success;
+        }
+
+        os::File::Close(file, &error);
+        return success && error == 0;
+    }
+
     void FreeCapturedManagedMemorySnapshot(Il2CppManagedMemorySnapshot* snapshot)
     {
         FreeIL2CppManagedHeap(snapshot->heap);
@@ -112,6 +112,8 @@ namespace MemoryInformation
     void ReportGcHeapSection(void* context, void* start, void* end);
     void ReportGcHandleTarget(Il2CppObject* obj, void* context);
     Il2CppManagedMemorySnapshot* CaptureManagedMemorySnapshot();
+    // Streams a snapshot of the same data to a file, flags are Il2CppMemorySnapshotFlags
+    bool WriteManagedMemorySnapshot(const char* path, int32_t flags);
     void FreeCapturedManagedMemorySnapshot(Il2CppManagedMemorySnapshot* snapshot);
 }
 }
@@ -14,6 +14,7 @@
 #include "os/Mutex.h"
 #include "utils/CallOnce.h"
 #include "utils/Collections.h"
+#include "utils/ConcurrentInternSet.h"
 #include "utils/Il2CppHashSet.h"
 #include "utils/Memory.h"
 #include "utils/PathUtils.h"
@@ -27,6 +28,7 @@
 #include "vm/Method.h"
 #include "vm/Object.h"
 #include "vm/Runtime.h"
+#include "vm/StartupTrace.h"
 #include "vm/String.h"
 #include "vm/Type.h"
 #include "vm-utils/MethodDefinitionKey.h"
@@ -37,8 +39,7 @@
 
 typedef Il2CppReaderWriterLockedHashMap<Il2CppClass*, Il2CppClass*> PointerTypeMap;
 
-typedef Il2CppHashSet<const Il2CppGenericMethod*, il2cpp::metadata::Il2CppGenericMethodHash, il2cpp::metadata::Il2CppGenericMethodCompare> Il2CppGenericMethodSet;
-typedef Il2CppGenericMethodSet::const_iterator Il2CppGenericMethodSetIter;
+typedef il2cpp::utils::ConcurrentInternSet<const Il2CppGenericMethod*, il2cpp::metadata::Il2CppGenericMethodHash, il2cpp::metadata::Il2CppGenericMethodCompare> Il2CppGenericMethodSet;
 static Il2CppGenericMethodSet s_GenericMethodSet;
 
 struct Il2CppMetadataCache
@@ -54,7 +55,7 @@ static int32_t s_AssembliesCount = 0;
 static Il2CppAssembly* s_AssembliesTable = NULL;
 
 
-typedef Il2CppReaderWriterLockedHashSet<const Il2CppGenericInst*, il2cpp::metadata::Il2CppGenericInstHash, il2cpp::metadata::Il2CppGenericInstCompare> Il2CppGenericInstSet;
+typedef il2cpp::utils::ConcurrentInternSet<const Il2CppGenericInst*, il2cpp::metadata::Il2CppGenericInstHash, il2cpp::metadata::Il2CppGenericInstCompare> Il2CppGenericInstSet;
 static Il2CppGenericInstSet s_GenericInstSet;
 
 typedef il2cpp::vm::Il2CppMethodTableMap::const_iterator Il2CppMethodTableMapIter;
@@ -142,6 +143,16 @@ Il2CppMetadataTypeHandle il2cpp::vm::MetadataCache::GetAssemblyExportedTypeHandl
     return il2cpp::vm::GlobalMetadata::GetAssemblyExportedTypeHandle(image, index);
 }
 
+bool il2cpp::vm::MetadataCache::HasTypeNameTable(const Il2CppImage* image)
+{
+    return il2cpp::vm::GlobalMetadata::HasTypeNameTable(image);
+}
+
+bool il2cpp::vm::MetadataCache::TryGetTypeHandleFromName(const Il2CppImage* image, const char* namespaze, const char* name, Il2CppMetadataTypeHandle* handle)
+{
+    return il2cpp::vm::GlobalMetadata::TryGetTypeHandleFromName(image, namespaze, name, handle);
+}
+
 const MethodInfo* il2cpp::vm::MetadataCache::GetMethodInfoFromMethodHandle(Il2CppMetadataMethodDefinitionHandle handle)
 {
     return il2cpp::vm::GlobalMetadata::GetMethodInfoFromMethodHandle(handle);
@@ -158,11 +169,16 @@ bool il2cpp::vm::MetadataCache::Initialize()
     il2cpp::metadata::GenericMetadata::SetMaximumRuntimeGenericDepth(s_Il2CppCodeGenOptions->maximumRuntimeGenericDepth);
     il2cpp::metadata::GenericMetadata::SetGenericVirtualIterations(s_Il2CppCodeGenOptions->recursiveGenericIterations);
 
-    s_GenericInstSet.Resize(s_MetadataCache_Il2CppMetadataRegistration->genericInstsCount);
+    s_GenericInstSet.Reserve(s_MetadataCache_Il2CppMetadataRegistration->genericInstsCount);
     for (int32_t i = 0; i < s_MetadataCache_Il2CppMetadataRegistration->genericInstsCount; i++)
     {
-        bool inserted = s_GenericInstSet.Add(s_MetadataCache_Il2CppMetadataRegistration->genericInsts[i]);
-        IL2CPP_ASSERT(inserted);
+        const Il2CppGenericInst* inst = s_MetadataCache_Il2CppMetadataRegistration->genericInsts[i];
+        const size_t hash = Il2CppGenericInstSet::Hash(inst);
+#if IL2CPP_DEBUG
+        const Il2CppGenericInst* existingInst;
+        IL2CPP_ASSERT(!s_GenericInstSet.Find(inst, hash, &existingInst));
+#endif
+        s_GenericInstSet.Add(inst, hash);
     }
 
     s_InteropData.assign_external(s_Il2CppCodeRegistration->interopData, s_Il2CppCodeRegistration->interopDataCount);
@@ -233,6 +249,7 @@ void il2cpp::vm::MetadataCache::ExecuteEagerStaticClassConstructors()
             {
                 Il2CppMetadataTypeHandle handle = GetTypeHandleFromIndex(image, *indexPointer);
                 Il2CppClass* klass = GlobalMetadata::GetTypeInfoFromHandle(handle);
+                StartupTracePhase phase(klass->name, klass->namespaze);
                 Runtime::ClassInit(klass);
                 indexPointer++;
             }
@@ -250,6 +267,7 @@ void il2cpp::vm::MetadataCache::ExecuteModuleInitializers()
         if (image->codeGenModule->moduleInitializer != NULL)
         {
             Il2CppModuleInitializerMethodPointer moduleInitializer = (Il2CppModuleInitializerMethodPointer)image->codeGenModule->moduleInitializer;
+            StartupTracePhase phase(image->name, NULL);
             moduleInitializer(NULL);
         }
     }
@@ -323,7 +341,7 @@ void il2cpp::vm::MetadataCache::Clear()
     s_AssembliesTable = NULL;
     s_AssembliesCount = 0;
 
-    s_GenericMethodSet.clear();
+    s_GenericMethodSet.Clear();
 
     metadata::ArrayMetadata::Clear();
 
@@ -445,14 +463,16 @@ const Il2CppGenericInst* il2cpp::vm::MetadataCache::GetGenericInst(const Il2CppT
     inst.type_argc = typeCount;
     inst.type_argv = (const Il2CppType**)types;
 
+    // The set is searched without a lock, the hash is computed once for both lookups and the insert
+    const size_t hash = Il2CppGenericInstSet::Hash(&inst);
     const Il2CppGenericInst* foundInst;
-    if (s_GenericInstSet.TryGet(&inst, &foundInst))
+    if (s_GenericInstSet.Find(&inst, hash, &foundInst))
         return foundInst;
 
     il2cpp::os::FastAutoLock lock(&g_MetadataLock);
 
     // Check if instance was added while we were blocked on g_MetadataLock
-    if (s_GenericInstSet.TryGet(&inst, &foundInst))
+    if (s_GenericInstSet.Find(&inst, hash, &foundInst))
         return foundInst;
 
     Il2CppGenericInst* newInst = NULL;
@@ -466,8 +486,7 @@ const Il2CppGenericInst* il2cpp::vm::MetadataCache::GetGenericInst(const Il2CppT
         newInst->type_argv[index] = *iter;
 
     // Do this while still holding the g_MetadataLock to prevent the same instance from being added twice
-    bool added = s_GenericInstSet.Add(newInst);
-    IL2CPP_ASSERT(added);
+    s_GenericInstSet.Add(newInst, hash);
     ++il2cpp_runtime_stats.generic_instance_count;
 
     return newInst;
@@ -481,17 +500,22 @@ const Il2CppGenericMethod* il2cpp::vm::MetadataCache::GetGenericMethod(const Met
     method.context.class_inst = classInst;
     method.context.method_inst = methodInst;
 
+    const size_t hash = Il2CppGenericMethodSet::Hash(&method);
+    const Il2CppGenericMethod* foundMethod;
+    if (s_GenericMethodSet.Find(&method, hash, &foundMethod))
+        return foundMethod;
+
     il2cpp::os::FastAutoLock lock(&s_GenericMethodMutex);
-    Il2CppGenericMethodSet::const_iterator iter = s_GenericMethodSet.find(&method);
-    if (iter != s_GenericMethodSet.end())
-        return *iter;
+
+    if (s_GenericMethodSet.Find(&method, hash, &foundMethod))
+        return foundMethod;
 
     Il2CppGenericMethod* newMethod = MetadataAllocGenericMethod();
     newMethod->methodDefinition = methodDefinition;
     newMethod->context.class_inst = classInst;
     newMethod->context.method_inst = methodInst;
 
-    s_GenericMethodSet.insert(newMethod);
+    s_GenericMethodSet.Add(newMethod, hash);
 
     return newMethod;
 }
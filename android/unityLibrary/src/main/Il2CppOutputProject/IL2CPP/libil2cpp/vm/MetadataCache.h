@@ -176,6 +176,8 @@ namespace vm
 
         static Il2CppMetadataTypeHandle GetAssemblyTypeHandle(const Il2CppImage* image, AssemblyTypeIndex index);
         static Il2CppMetadataTypeHandle GetAssemblyExportedTypeHandle(const Il2CppImage* image, AssemblyExportedTypeIndex index);
+        static bool HasTypeNameTable(const Il2CppImage* image);
+        static bool TryGetTypeHandleFromName(const Il2CppImage* image, const char* namespaze, const char* name, Il2CppMetadataTypeHandle* handle);
 
         static const MethodInfo* GetMethodInfoFromCatchPoint(const Il2CppImage* image, const Il2CppCatchPoint* cp);
         static const MethodInfo* GetMethodInfoFromSequencePoint(const Il2CppImage* image, const Il2CppSequencePoint* cp);
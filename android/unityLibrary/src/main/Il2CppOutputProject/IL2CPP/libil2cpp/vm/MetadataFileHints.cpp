@@ -0,0 +1,170 @@
+#include "il2cpp-config.h"
+#include "il2cpp-api-types.h"
+#include "os/MemoryMappedFile.h"
+#include "os/Time.h"
+#include "vm/GlobalMetadataFileInternals.h"
+#include "vm/MetadataFileHints.h"
+#include "utils/Logging.h"
+
+namespace il2cpp
+{
+namespace vm
+{
+    enum MetadataSectionUse
+    {
+        kSectionCold = 0,
+        // Read while images, assemblies and classes are set up during startup
+        kSectionHot = 1,
+        // Hot and small enough per entry that nearly every page of it ends up being touched
+        kSectionHotLocked = 2
+    };
+
+    struct MetadataSection
+    {
+        const char* name;
+        int32_t offset;
+        int32_t size;
+        MetadataSectionUse use;
+        int64_t residentPagesAtLoad;
+    };
+
+#define METADATA_SECTION(field, use) { #field, header->field##Offset, header->field##Size, use, -1 }
+
+    static const int kMaxMetadataSections = 32;
+
+    static int32_t s_Hints;
+    static const void* s_Metadata;
+    static MetadataSection s_Sections[kMaxMetadataSections];
+    static int s_SectionCount;
+    static int64_t s_LoadTicks;
+    static int64_t s_ApplyTicks;
+
+    static void InitializeSections(const Il2CppGlobalMetadataHeader* header)
+    {
+        const MetadataSection sections[] =
+        {
+            METADATA_SECTION(stringLiteral, kSectionCold),
+            METADATA_SECTION(stringLiteralData, kSectionCold),
+            METADATA_SECTION(string, kSectionHot),
+            METADATA_SECTION(events, kSectionCold),
+            METADATA_SECTION(properties, kSectionCold),
+            METADATA_SECTION(methods, kSectionHotLocked),
+            METADATA_SECTION(parameterDefaultValues, kSectionCold),
+            METADATA_SECTION(fieldDefaultValues, kSectionCold),
+            METADATA_SECTION(fieldAndParameterDefaultValueData, kSectionCold),
+            METADATA_SECTION(fieldMarshaledSizes, kSectionCold),
+            METADATA_SECTION(parameters, kSectionHot),
+            METADATA_SECTION(fields, kSectionHot),
+            METADATA_SECTION(genericParameters, kSectionHot),
+            METADATA_SECTION(genericParameterConstraints, kSectionCold),
+            METADATA_SECTION(genericContainers, kSectionHot),
+            METADATA_SECTION(nestedTypes, kSectionHot),
+            METADATA_SECTION(interfaces, kSectionHot),
+            METADATA_SECTION(vtableMethods, kSectionHot),
+            METADATA_SECTION(interfaceOffsets, kSectionHot),
+            METADATA_SECTION(typeDefinitions, kSectionHotLocked),
+            METADATA_SECTION(images, kSectionHotLocked),
+            METADATA_SECTION(assemblies, kSectionHotLocked),
+            METADATA_SECTION(fieldRefs, kSectionHot),
+            METADATA_SECTION(referencedAssemblies, kSectionHotLocked),
+            METADATA_SECTION(attributeData, kSectionCold),
+            METADATA_SECTION(attributeDataRange, kSectionCold),
+            METADATA_SECTION(unresolvedIndirectCallParameterTypes, kSectionCold),
+            METADATA_SECTION(unresolvedIndirectCallParameterRanges, kSectionCold),
+            METADATA_SECTION(windowsRuntimeTypeNames, kSectionCold),
+            METADATA_SECTION(windowsRuntimeStrings, kSectionCold),
+            METADATA_SECTION(exportedTypeDefinitions, kSectionCold),
+        };
+
+        static_assert(sizeof(sections) / sizeof(sections[0]) <= kMaxMetadataSections, "kMaxMetadataSections is too small");
+
+        s_SectionCount = sizeof(sections) / sizeof(sections[0]);
+        for (int i = 0; i < s_SectionCount; ++i)
+            s_Sections[i] = sections[i];
+    }
+
+#undef METADATA_SECTION
+
+    static void* GetSectionAddress(const MetadataSection& section)
+    {
+        return const_cast<char*>(static_cast<const char*>(s_Metadata) + section.offset);
+    }
+
+    void MetadataFileHints::SetHints(int32_t hints)
+    {
+        s_Hints = hints;
+    }
+
+    void MetadataFileHints::Apply(const void* metadata)
+    {
+        if (s_Hints == IL2CPP_METADATA_FILE_HINT_NONE)
+            return;
+
+        s_Metadata = metadata;
+        s_LoadTicks = os::Time::GetTicks100NanosecondsMonotonic();
+        InitializeSections(static_cast<const Il2CppGlobalMetadataHeader*>(metadata));
+
+        // Sample residency before any hint is applied, so the trace tells a cold start from a warm one
+        if (s_Hints & IL2CPP_METADATA_FILE_HINT_TRACE)
+        {
+            for (int i = 0; i < s_SectionCount; ++i)
+            {
+                int64_t resident, total;
+                if (os::MemoryMappedFile::GetResidentPageCount(GetSectionAddress(s_Sections[i]), s_Sections[i].size, &resident, &total))
+                    s_Sections[i].residentPagesAtLoad = resident;
+            }
+        }
+
+        if (s_Hints & IL2CPP_METADATA_FILE_HINT_PREFETCH)
+        {
+            for (int i = 0; i < s_SectionCount; ++i)
+            {
+                if (s_Sections[i].use != kSectionCold)
+                    os::MemoryMappedFile::AdviseWillNeed(GetSectionAddress(s_Sections[i]), s_Sections[i].size);
+            }
+        }
+
+        // Locking faults the pages in synchronously, so it only starts once every read ahead has been issued
+        int32_t lockFailures = 0;
+        if (s_Hints & IL2CPP_METADATA_FILE_HINT_LOCK)
+        {
+            for (int i = 0; i < s_SectionCount; ++i)
+            {
+                if (s_Sections[i].use == kSectionHotLocked && !os::MemoryMappedFile::LockResident(GetSectionAddress(s_Sections[i]), s_Sections[i].size))
+                    lockFailures++;
+            }
+        }
+
+        s_ApplyTicks = os::Time::GetTicks100NanosecondsMonotonic() - s_LoadTicks;
+
+        if (lockFailures > 0 && (s_Hints & IL2CPP_METADATA_FILE_HINT_TRACE))
+            utils::Logging::Write("WARNING: Could not lock %d global-metadata.dat sections in memory, the process may exceed its locked memory limit", lockFailures);
+    }
+
+    void MetadataFileHints::TraceStartup()
+    {
+        if (s_Metadata == NULL || !(s_Hints & IL2CPP_METADATA_FILE_HINT_TRACE))
+            return;
+
+        int64_t startupTicks = os::Time::GetTicks100NanosecondsMonotonic() - s_LoadTicks;
+        utils::Logging::Write("global-metadata.dat startup trace: hints 0x%x applied in %lld us, %lld us from load to end of runtime initialization",
+            s_Hints, (long long)(s_ApplyTicks / 10), (long long)(startupTicks / 10));
+
+        // Pages that became resident in between were faulted in or read ahead during startup
+        for (int i = 0; i < s_SectionCount; ++i)
+        {
+            const MetadataSection& section = s_Sections[i];
+
+            int64_t resident, total;
+            if (section.size <= 0 || !os::MemoryMappedFile::GetResidentPageCount(GetSectionAddress(section), section.size, &resident, &total))
+                continue;
+
+            utils::Logging::Write("  %-40s %10d bytes %s resident pages: %lld at load, %lld of %lld at end of startup",
+                section.name, section.size, section.use == kSectionCold ? "cold" : "hot ",
+                (long long)section.residentPagesAtLoad, (long long)resident, (long long)total);
+        }
+
+        s_Metadata = NULL;
+    }
+} /* namespace vm */
+} /* namespace il2cpp */
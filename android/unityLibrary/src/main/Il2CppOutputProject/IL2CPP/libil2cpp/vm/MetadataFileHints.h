@@ -0,0 +1,25 @@
+#pragma once
+
+#include <stdint.h>
+#include "il2cpp-config.h"
+
+namespace il2cpp
+{
+namespace vm
+{
+    // Page access hints for the sections of global-metadata.dat that are read during startup,
+    // see Il2CppMetadataFileHints for the available options.
+    class LIBIL2CPP_CODEGEN_API MetadataFileHints
+    {
+    public:
+        // Must be called before the runtime is initialized
+        static void SetHints(int32_t hints);
+
+        // Called by GlobalMetadata::Initialize as soon as the file is mapped
+        static void Apply(const void* metadata);
+
+        // Called at the end of Runtime::Init, logs the page residency of each section if tracing was requested
+        static void TraceStartup();
+    };
+} /* namespace vm */
+} /* namespace il2cpp */
@@ -10,6 +10,14 @@
 
 void* il2cpp::vm::MetadataLoader::LoadMetadataFile(const char* fileName)
 {
+    int64_t unused;
+    return LoadMetadataFile(fileName, &unused);
+}
+
+void* il2cpp::vm::MetadataLoader::LoadMetadataFile(const char* fileName, int64_t* fileSize)
+{
+    *fileSize = 0;
+
     std::string resourcesDirectory = utils::PathUtils::Combine(utils::Runtime::GetDataDir(), utils::StringView<char>("Metadata"));
 
     std::string resourceFilePath = utils::PathUtils::Combine(resourcesDirectory, utils::StringView<char>(fileName, strlen(fileName)));
@@ -22,6 +30,13 @@ void* il2cpp::vm::MetadataLoader::LoadMetadataFile(const char* fileName)
         return NULL;
     }
 
+    int64_t length = os::File::GetLength(handle, &error);
+    if (error != 0)
+    {
+        length = 0;
+        error = 0;
+    }
+
     void* fileBuffer = utils::MemoryMappedFile::Map(handle);
 
     os::File::Close(handle, &error);
@@ -32,6 +47,9 @@ void* il2cpp::vm::MetadataLoader::LoadMetadataFile(const char* fileName)
         return NULL;
     }
 
+    if (fileBuffer != NULL)
+        *fileSize = length;
+
     return fileBuffer;
 }
 
@@ -9,6 +9,8 @@ namespace vm
     {
     public:
         static void* LoadMetadataFile(const char* fileName);
+        // Also reports the size of the file, or 0 when it could not be determined
+        static void* LoadMetadataFile(const char* fileName, int64_t* fileSize);
         static void UnloadMetadataFile(void* fileBuffer);
     };
 } // namespace vm
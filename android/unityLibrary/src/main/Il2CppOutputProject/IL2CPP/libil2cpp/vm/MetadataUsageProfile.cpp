@@ -0,0 +1,268 @@
+#include "il2cpp-config.h"
+#include "il2cpp-object-internals.h"
+#include "il2cpp-runtime-stats.h"
+#include "os/File.h"
+#include "os/Thread.h"
+#include "os/Time.h"
+#include "vm/Domain.h"
+#include "vm/GlobalMetadata.h"
+#include "vm/MetadataUsageProfile.h"
+#include "vm/Thread.h"
+#include "utils/Logging.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+// Profile file layout, all integers little endian:
+//   uint32_t magic, uint32_t version, uint32_t metadata usage count, uint32_t slot count
+//   followed by the sorted slot indices, each stored as the LEB128 encoded distance to the previous one
+
+namespace il2cpp
+{
+namespace vm
+{
+    static const uint32_t kProfileMagic = 0x50554D49; // "IMUP"
+    static const uint32_t kProfileVersion = 1;
+    static const int32_t kMaxPreloadThreads = 16;
+
+    static std::string s_ProfilePath;
+    static int32_t s_PreloadThreadCount;
+
+    // Slots listed in the profile that was preloaded, sorted
+    static std::vector<uint32_t> s_PreloadedUsages;
+
+    struct PreloadRange
+    {
+        const uint32_t* usages;
+        size_t count;
+    };
+
+    static void PreloadUsages(const PreloadRange& range)
+    {
+        for (size_t i = 0; i < range.count; ++i)
+        {
+            // A slot that fails to resolve now will report the error when generated code reaches it
+            try
+            {
+                GlobalMetadata::PreloadRuntimeMetadataUsage(range.usages[i]);
+            }
+            catch (Il2CppExceptionWrapper&)
+            {
+            }
+        }
+    }
+
+    static void PreloadThreadStart(void* arg)
+    {
+        Il2CppThread* thread = Thread::Attach(Domain::GetRoot());
+        PreloadUsages(*static_cast<PreloadRange*>(arg));
+        Thread::Detach(thread);
+    }
+
+    static bool ReadProfile(const std::string& path, std::vector<uint8_t>& contents)
+    {
+        int error = 0;
+        os::FileHandle* handle = os::File::Open(path, kFileModeOpen, kFileAccessRead, kFileShareRead, kFileOptionsNone, &error);
+        if (error != 0)
+            return false;
+
+        int64_t length = os::File::GetLength(handle, &error);
+        if (error == 0 && length > 0 && length < INT32_MAX)
+        {
+            contents.resize((size_t)length);
+            int read = os::File::Read(handle, (char*)contents.data(), (int)length, &error);
+            if (error != 0 || read != (int)length)
+                contents.clear();
+        }
+
+        os::File::Close(handle, &error);
+        return !contents.empty();
+    }
+
+    static bool ReadUInt32(const uint8_t*& cursor, const uint8_t* end, uint32_t* value)
+    {
+        if (end - cursor < 4)
+            return false;
+
+        *value = (uint32_t)cursor[0] | ((uint32_t)cursor[1] << 8) | ((uint32_t)cursor[2] << 16) | ((uint32_t)cursor[3] << 24);
+        cursor += 4;
+        return true;
+    }
+
+    static bool ReadVarUInt32(const uint8_t*& cursor, const uint8_t* end, uint32_t* value)
+    {
+        uint32_t result = 0;
+        for (int shift = 0; shift < 35 && cursor < end; shift += 7)
+        {
+            uint8_t byte = *cursor++;
+            result |= (uint32_t)(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0)
+            {
+                *value = result;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    static void WriteUInt32(std::vector<uint8_t>& buffer, uint32_t value)
+    {
+        for (int i = 0; i < 4; ++i)
+            buffer.push_back((uint8_t)(value >> (i * 8)));
+    }
+
+    static void WriteVarUInt32(std::vector<uint8_t>& buffer, uint32_t value)
+    {
+        while (value >= 0x80)
+        {
+            buffer.push_back((uint8_t)(value | 0x80));
+            value >>= 7;
+        }
+        buffer.push_back((uint8_t)value);
+    }
+
+    static bool DecodeProfile(const std::vector<uint8_t>& contents, std::vector<uint32_t>& usages)
+    {
+        const uint8_t* cursor = contents.data();
+        const uint8_t* end = cursor + contents.size();
+
+        uint32_t magic, version, usageCount, slotCount;
+        if (!ReadUInt32(cursor, end, &magic) || !ReadUInt32(cursor, end, &version) || !ReadUInt32(cursor, end, &usageCount) || !ReadUInt32(cursor, end, &slotCount))
+            return false;
+
+        // A profile recorded against different generated code is useless, slot indices would not line up
+        if (magic != kProfileMagic || version != kProfileVersion || usageCount != GlobalMetadata::GetRuntimeMetadataUsageCount() || slotCount > usageCount)
+            return false;
+
+        usages.reserve(slotCount);
+
+        uint32_t previous = 0;
+        for (uint32_t i = 0; i < slotCount; ++i)
+        {
+            uint32_t delta;
+            if (!ReadVarUInt32(cursor, end, &delta))
+                return false;
+
+            uint32_t usage = previous + delta;
+            if (usage >= usageCount || (i > 0 && delta == 0))
+                return false;
+
+            usages.push_back(usage);
+            previous = usage;
+        }
+
+        return true;
+    }
+
+    void MetadataUsageProfile::SetPreloadProfile(const char* path, int32_t preloadThreadCount)
+    {
+        s_ProfilePath = path != NULL ? path : "";
+        s_PreloadThreadCount = std::max(0, std::min(preloadThreadCount, kMaxPreloadThreads));
+    }
+
+    void MetadataUsageProfile::Preload()
+    {
+        if (s_ProfilePath.empty())
+            return;
+
+        std::vector<uint8_t> contents;
+        if (!ReadProfile(s_ProfilePath, contents))
+            return;
+
+        int64_t startTicks = os::Time::GetTicks100NanosecondsMonotonic();
+
+        s_PreloadedUsages.clear();
+        if (!DecodeProfile(contents, s_PreloadedUsages))
+        {
+            utils::Logging::Write("WARNING: Ignoring metadata usage profile %s, it is corrupt or was recorded for a different build", s_ProfilePath.c_str());
+            s_PreloadedUsages.clear();
+            return;
+        }
+
+        const size_t usageCount = s_PreloadedUsages.size();
+        const size_t rangeCount = (size_t)s_PreloadThreadCount + 1;
+
+        std::vector<PreloadRange> ranges(rangeCount);
+        for (size_t i = 0; i < rangeCount; ++i)
+        {
+            size_t begin = usageCount * i / rangeCount;
+            size_t end = usageCount * (i + 1) / rangeCount;
+            ranges[i].usages = s_PreloadedUsages.data() + begin;
+            ranges[i].count = end - begin;
+        }
+
+        std::vector<os::Thread*> threads;
+        for (size_t i = 1; i < rangeCount; ++i)
+        {
+            os::Thread* thread = new os::Thread();
+            if (thread->Run(PreloadThreadStart, &ranges[i]) == os::kErrorCodeSuccess)
+            {
+                threads.push_back(thread);
+            }
+            else
+            {
+                delete thread;
+                PreloadUsages(ranges[i]);
+            }
+        }
+
+        PreloadUsages(ranges[0]);
+
+        for (size_t i = 0; i < threads.size(); ++i)
+        {
+            threads[i]->Join();
+            delete threads[i];
+        }
+
+        il2cpp_runtime_stats.metadata_usage_preload_count += usageCount;
+        il2cpp_runtime_stats.metadata_usage_preload_time_usecs += (uint64_t)(os::Time::GetTicks100NanosecondsMonotonic() - startTicks) / 10;
+    }
+
+    bool MetadataUsageProfile::Write(const char* path)
+    {
+        const uint32_t usageCount = GlobalMetadata::GetRuntimeMetadataUsageCount();
+
+        std::vector<uint32_t> initialized;
+        uint32_t missedCount = 0;
+        for (uint32_t i = 0; i < usageCount; ++i)
+        {
+            if (!GlobalMetadata::IsRuntimeMetadataUsageInitialized(i))
+                continue;
+
+            initialized.push_back(i);
+            if (!s_PreloadedUsages.empty() && !std::binary_search(s_PreloadedUsages.begin(), s_PreloadedUsages.end(), i))
+                missedCount++;
+        }
+
+        std::vector<uint8_t> buffer;
+        buffer.reserve(16 + initialized.size() * 2);
+        WriteUInt32(buffer, kProfileMagic);
+        WriteUInt32(buffer, kProfileVersion);
+        WriteUInt32(buffer, usageCount);
+        WriteUInt32(buffer, (uint32_t)initialized.size());
+
+        uint32_t previous = 0;
+        for (size_t i = 0; i < initialized.size(); ++i)
+        {
+            WriteVarUInt32(buffer, initialized[i] - previous);
+            previous = initialized[i];
+        }
+
+        int error = 0;
+        os::FileHandle* handle = os::File::Open(path, kFileModeCreate, kFileAccessWrite, kFileShareNone, kFileOptionsNone, &error);
+        if (error != 0)
+            return false;
+
+        int32_t written = os::File::Write(handle, (const char*)buffer.data(), (int)buffer.size(), &error);
+        bool success = error == 0 && written == (int32_t)buffer.size();
+        os::File::Close(handle, &error);
+
+        if (!s_PreloadedUsages.empty())
+            utils::Logging::Write("Metadata usage profile: %u of %u initialized slots were resolved lazily although a profile was preloaded", missedCount, (uint32_t)initialized.size());
+
+        return success && error == 0;
+    }
+} /* namespace vm */
+} /* namespace il2cpp */
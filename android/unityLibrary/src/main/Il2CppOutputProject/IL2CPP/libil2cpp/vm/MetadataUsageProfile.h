@@ -0,0 +1,27 @@
+#pragma once
+
+#include <stdint.h>
+#include "il2cpp-config.h"
+
+namespace il2cpp
+{
+namespace vm
+{
+    // Records which runtime metadata usage slots (the targets of il2cpp_codegen_initialize_runtime_metadata)
+    // were initialized during a run, and resolves that set up front on later runs, so the first execution
+    // of a method does not have to decode and resolve its metadata on the spot.
+    class LIBIL2CPP_CODEGEN_API MetadataUsageProfile
+    {
+    public:
+        // Must be called before the runtime is initialized. With preloadThreadCount > 0 the profile is
+        // resolved by that many extra threads alongside the main thread.
+        static void SetPreloadProfile(const char* path, int32_t preloadThreadCount);
+
+        // Resolves the slots listed in the profile set with SetPreloadProfile, called from Runtime::Init
+        static void Preload();
+
+        // Writes the set of slots initialized so far, returns false if the file could not be written
+        static bool Write(const char* path);
+    };
+} /* namespace vm */
+} /* namespace il2cpp */
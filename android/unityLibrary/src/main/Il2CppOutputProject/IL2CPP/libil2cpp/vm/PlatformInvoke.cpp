@@ -1,6 +1,7 @@
 #include "il2cpp-config.h"
 #include "il2cpp-object-internals.h"
 #include "il2cpp-class-internals.h"
+#include "il2cpp-runtime-stats.h"
 
 #include "PlatformInvoke.h"
 #include "Exception.h"
@@ -13,6 +14,7 @@
 #include "gc/WriteBarrier.h"
 #include "os/LibraryLoader.h"
 #include "os/MarshalStringAlloc.h"
+#include "os/Time.h"
 #include "utils/Memory.h"
 #include "utils/StringUtils.h"
 #include "vm-utils/VmStringUtils.h"
@@ -29,7 +31,28 @@ namespace vm
         os::LibraryLoader::SetFindPluginCallback(method);
     }
 
+    static Il2CppMethodPointer ResolveUncached(const PInvokeArguments& pinvokeArgs);
+
     Il2CppMethodPointer PlatformInvoke::Resolve(const PInvokeArguments& pinvokeArgs)
+    {
+        // Every call site caches its own function pointer, but the same entry point is usually
+        // imported from many call sites, so share the result of the library and symbol lookups.
+        Il2CppMethodPointer function;
+        if (os::LibraryLoader::TryGetCachedFunctionPointer(pinvokeArgs, &function))
+            return function;
+
+        int64_t startTicks = os::Time::GetTicks100NanosecondsMonotonic();
+
+        function = ResolveUncached(pinvokeArgs);
+        os::LibraryLoader::CacheFunctionPointer(pinvokeArgs, function);
+
+        ++il2cpp_runtime_stats.pinvoke_resolve_count;
+        il2cpp_runtime_stats.pinvoke_resolve_time_usecs += (uint64_t)(os::Time::GetTicks100NanosecondsMonotonic() - startTicks) / 10;
+
+        return function;
+    }
+
+    static Il2CppMethodPointer ResolveUncached(const PInvokeArguments& pinvokeArgs)
     {
         // Before resolving a P/Invoke, check against a hardcoded list of "known P/Invokes" that is different for every platform.
         // This bit solves several different problems we have when P/Invoking into native system libraries from mscorlib.dll.
@@ -80,19 +103,51 @@ namespace vm
             MarshalAlloc::Free(ptr);
     }
 
+    // Marshaled strings stop at the first embedded null character, like strlen on the native side would
+    static inline size_t GetLengthUpToNullTerminator(Il2CppString* managedString)
+    {
+        const Il2CppChar* nullTerminator = std::find(managedString->chars, managedString->chars + managedString->length, 0);
+        return (size_t)(nullTerminator - managedString->chars);
+    }
+
     char* PlatformInvoke::MarshalCSharpStringToCppString(Il2CppString* managedString)
     {
         if (managedString == NULL)
             return NULL;
 
-        std::string utf8String = utils::StringUtils::Utf16ToUtf8(managedString->chars);
+        size_t utf16Length = GetLengthUpToNullTerminator(managedString);
+        size_t utf8Length = utils::StringUtils::GetUtf8LengthOfUtf16(managedString->chars, utf16Length);
 
-        char* nativeString = MarshalAllocateStringBuffer<char>(utf8String.size() + 1);
-        strcpy(nativeString, utf8String.c_str());
+        char* nativeString = MarshalAllocateStringBuffer<char>(utf8Length + 1);
+        utils::StringUtils::TranscodeUtf16ToUtf8(managedString->chars, utf16Length, nativeString, utf8Length);
+        nativeString[utf8Length] = '\0';
 
         return nativeString;
     }
 
+    char* PlatformInvoke::MarshalCSharpStringToCppStringBuffered(Il2CppString* managedString, char* buffer, size_t bufferSize)
+    {
+        if (managedString == NULL)
+            return NULL;
+
+        size_t utf16Length = GetLengthUpToNullTerminator(managedString);
+
+        // Every UTF-16 code unit needs at most three UTF-8 bytes, so most strings can skip the length pass
+        size_t utf8Length = utf16Length * 3 < bufferSize ? utf16Length * 3 : utils::StringUtils::GetUtf8LengthOfUtf16(managedString->chars, utf16Length);
+
+        char* nativeString = utf8Length < bufferSize ? buffer : MarshalAllocateStringBuffer<char>(utf8Length + 1);
+        utf8Length = utils::StringUtils::TranscodeUtf16ToUtf8(managedString->chars, utf16Length, nativeString, utf8Length);
+        nativeString[utf8Length] = '\0';
+
+        return nativeString;
+    }
+
+    void PlatformInvoke::MarshalFreeBuffered(void* ptr, void* buffer)
+    {
+        if (ptr != buffer)
+            MarshalFree(ptr);
+    }
+
     void PlatformInvoke::MarshalCSharpStringToCppStringFixed(Il2CppString* managedString, char* buffer, int numberOfCharacters)
     {
         if (managedString == NULL)
@@ -101,8 +156,9 @@ namespace vm
         }
         else
         {
-            std::string utf8String = utils::StringUtils::Utf16ToUtf8(managedString->chars, numberOfCharacters - 1);
-            strcpy(buffer, utf8String.c_str());
+            size_t utf16Length = GetLengthUpToNullTerminator(managedString);
+            size_t utf8Length = utils::StringUtils::TranscodeUtf16ToUtf8(managedString->chars, utf16Length, buffer, numberOfCharacters - 1);
+            buffer[utf8Length] = '\0';
         }
     }
 
@@ -326,16 +382,19 @@ namespace vm
         if (stringBuilder == NULL || buffer == NULL)
             return;
 
-        UTF16String utf16String = utils::StringUtils::Utf8ToUtf16(buffer);
-
-        IL2CPP_OBJECT_SETREF(stringBuilder, chunkChars, il2cpp::vm::Array::New(il2cpp_defaults.char_class, (int)utf16String.size() + 1));
+        size_t utf8Length = strlen(buffer);
+        size_t utf16Length;
+        if (!utils::StringUtils::GetUtf16LengthOfUtf8(buffer, utf8Length, &utf16Length))
+            utf16Length = 0;
 
-        for (int i = 0; i < (int)utf16String.size(); i++)
-            il2cpp_array_set(stringBuilder->chunkChars, Il2CppChar, i, utf16String[i]);
+        IL2CPP_OBJECT_SETREF(stringBuilder, chunkChars, il2cpp::vm::Array::New(il2cpp_defaults.char_class, (int)utf16Length + 1));
 
-        il2cpp_array_set(stringBuilder->chunkChars, Il2CppChar, (int)utf16String.size(), '\0');
+        Il2CppChar* chars = il2cpp_array_addr(stringBuilder->chunkChars, Il2CppChar, 0);
+        if (utf16Length != 0)
+            utils::StringUtils::TranscodeUtf8ToUtf16(buffer, utf8Length, chars);
+        chars[utf16Length] = '\0';
 
-        stringBuilder->chunkLength = (int)utf16String.size();
+        stringBuilder->chunkLength = (int)utf16Length;
         stringBuilder->chunkOffset = 0;
         IL2CPP_OBJECT_SETREF_NULL(stringBuilder, chunkPrevious);
     }
@@ -30,8 +30,11 @@ namespace vm
         static Il2CppMethodPointer Resolve(const PInvokeArguments& pinvokeArgs);
 
         static void MarshalFree(void* ptr);
+        static void MarshalFreeBuffered(void* ptr, void* buffer);
 
         static char* MarshalCSharpStringToCppString(Il2CppString* managedString);
+        // Writes into buffer when the result fits, otherwise allocates. Release with MarshalFreeBuffered.
+        static char* MarshalCSharpStringToCppStringBuffered(Il2CppString* managedString, char* buffer, size_t bufferSize);
         static void MarshalCSharpStringToCppStringFixed(Il2CppString* managedString, char* buffer, int numberOfCharacters);
         static Il2CppChar* MarshalCSharpStringToCppWString(Il2CppString* managedString);
         static void MarshalCSharpStringToCppWStringFixed(Il2CppString* managedString, Il2CppChar* buffer, int numberOfCharacters);
@@ -21,6 +21,7 @@
 #include "vm/COMEntryPoints.h"
 #include "vm/Class.h"
 #include "vm/Domain.h"
+#include "vm/Enum.h"
 #include "vm/Exception.h"
 #include "vm/Field.h"
 #include "gc/GCHandle.h"
@@ -29,12 +30,15 @@
 #include "vm/MetadataAlloc.h"
 #include "vm/MetadataCache.h"
 #include "vm/MetadataLock.h"
+#include "vm/MetadataFileHints.h"
+#include "vm/MetadataUsageProfile.h"
 #include "vm/Method.h"
 #include "vm/Reflection.h"
 #include "vm/Runtime.h"
 #include "vm/Thread.h"
 #include "vm/Type.h"
 #include "vm/StackTrace.h"
+#include "vm/StartupTrace.h"
 #include "vm/String.h"
 #include "vm/Object.h"
 #include "vm-utils/Debugger.h"
@@ -150,6 +154,9 @@ namespace vm
         if (s_RuntimeInitCount++ > 0)
             return true;
 
+        StartupTrace::Start();
+        StartupTrace::BeginPhase("Runtime::Init", NULL);
+
         SanityChecks();
 
 #if IL2CPP_MONO_DEBUGGER
@@ -167,6 +174,7 @@ namespace vm
 
         il2cpp::icalls::mscorlib::System::Reflection::RuntimeAssembly::AllocateStaticData();
 
+        StartupTrace::BeginPhase("Platform initialization", NULL);
         os::Initialize();
         os::Locale::Initialize();
         MetadataAllocInitialize();
@@ -184,25 +192,40 @@ namespace vm
         // Has to happen after Thread::Init() due to it needing a COM apartment on Windows
         il2cpp::os::SynchronizationContext::Initialize();
 #endif
+        StartupTrace::EndPhase();
+
+        {
+            StartupTracePhase phase("Code registration");
 
-        // This should be filled in by generated code.
-        IL2CPP_ASSERT(g_CodegenRegistration != NULL);
-        g_CodegenRegistration();
+            // This should be filled in by generated code.
+            IL2CPP_ASSERT(g_CodegenRegistration != NULL);
+            g_CodegenRegistration();
+        }
 
-        if (!MetadataCache::Initialize())
         {
-            s_RuntimeInitCount--;
-            return false;
+            StartupTracePhase phase("MetadataCache::Initialize");
+            if (!MetadataCache::Initialize())
+            {
+                s_RuntimeInitCount--;
+                StartupTrace::Finish();
+                return false;
+            }
+
+            Assembly::Initialize();
         }
 
-        Assembly::Initialize();
-        gc::GarbageCollector::Initialize();
+        {
+            StartupTracePhase phase("GC initialization");
+            gc::GarbageCollector::Initialize();
 
-        // Thread needs GC initialized
-        Thread::Initialize();
+            // Thread needs GC initialized
+            Thread::Initialize();
+        }
 
         register_allocator(il2cpp::utils::Memory::Malloc, il2cpp::utils::Memory::Free);
 
+        StartupTrace::BeginPhase("Corlib class setup", NULL);
+
         memset(&il2cpp_defaults, 0, sizeof(Il2CppDefaults));
 
         const Il2CppAssembly* assembly = Assembly::Load("mscorlib.dll");
@@ -334,6 +357,9 @@ namespace vm
         }
 
         Class::Init(il2cpp_defaults.string_class);
+        StartupTrace::EndPhase();
+
+        StartupTrace::BeginPhase("Domain and thread setup", NULL);
 
         os::Socket::Startup();
 
@@ -391,14 +417,35 @@ namespace vm
             const char* mainArgs[] = { executablePath.c_str() };
             utils::Environment::SetMainArgs(mainArgs, 1);
         }
+        StartupTrace::EndPhase();
 
-        vm::MetadataCache::ExecuteEagerStaticClassConstructors();
-        vm::MetadataCache::ExecuteModuleInitializers();
+        {
+            StartupTracePhase phase("Metadata usage preload");
+            MetadataUsageProfile::Preload();
+        }
+
+        {
+            StartupTracePhase phase("Eager static constructors");
+            vm::MetadataCache::ExecuteEagerStaticClassConstructors();
+        }
+
+        {
+            StartupTracePhase phase("Module initializers");
+            vm::MetadataCache::ExecuteModuleInitializers();
+        }
 
 #if !IL2CPP_MONO_DEBUGGER
-        il2cpp::utils::DebugSymbolReader::LoadDebugSymbols();
+        {
+            StartupTracePhase phase("Debug symbols");
+            il2cpp::utils::DebugSymbolReader::LoadDebugSymbols();
+        }
 #endif
 
+        MetadataFileHints::TraceStartup();
+
+        StartupTrace::EndPhase();
+        StartupTrace::Finish();
+
         return true;
     }
 
@@ -490,6 +537,8 @@ namespace vm
 
         // We need to do this before UninitializeGC because it uses (fixed) GC memory
         Reflection::ClearStatics();
+        Type::ClearNameCache();
+        Enum::ClearCache();
 
         // We need to do this after thread shut down because it is freeing GC fixed memory
         il2cpp::gc::GarbageCollector::UninitializeGC();
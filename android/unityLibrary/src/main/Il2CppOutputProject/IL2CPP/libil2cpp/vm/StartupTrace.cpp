@@ -0,0 +1,155 @@
+#include "il2cpp-config.h"
+#include "os/Environment.h"
+#include "os/File.h"
+#include "os/Time.h"
+#include "vm/StartupTrace.h"
+#include "utils/Logging.h"
+#include "utils/StringUtils.h"
+
+#include <string>
+#include <vector>
+
+namespace il2cpp
+{
+namespace vm
+{
+    struct StartupPhase
+    {
+        const char* name;
+        const char* detail;
+        int64_t startTicks;
+        int64_t endTicks;
+    };
+
+    static std::string s_OutputPath;
+    // Set by SetOutputPath, which then takes precedence over IL2CPP_STARTUP_TRACE even when it disabled recording
+    static bool s_OutputPathSet;
+    static bool s_Recording;
+    static std::vector<StartupPhase> s_Phases;
+    // Indices in s_Phases of the phases that have not ended yet, innermost last
+    static std::vector<size_t> s_OpenPhases;
+
+    void StartupTrace::SetOutputPath(const char* path)
+    {
+        s_OutputPath = path != NULL ? path : "";
+        s_OutputPathSet = true;
+    }
+
+    void StartupTrace::Start()
+    {
+        if (!s_OutputPathSet)
+            s_OutputPath = os::Environment::GetEnvironmentVariable("IL2CPP_STARTUP_TRACE");
+
+        if (s_OutputPath.empty())
+            return;
+
+        s_Phases.clear();
+        s_Phases.reserve(1024);
+        s_OpenPhases.clear();
+        s_Recording = true;
+    }
+
+    void StartupTrace::Finish()
+    {
+        if (!s_Recording)
+            return;
+
+        // Phases left open by an early return end here
+        while (!s_OpenPhases.empty())
+            EndPhase();
+
+        s_Recording = false;
+
+        if (!Write(s_OutputPath.c_str()))
+            utils::Logging::Write("WARNING: Could not write the startup trace to %s", s_OutputPath.c_str());
+    }
+
+    void StartupTrace::BeginPhase(const char* name, const char* detail)
+    {
+        if (!s_Recording)
+            return;
+
+        StartupPhase phase = { name, detail, os::Time::GetTicks100NanosecondsMonotonic(), 0 };
+        s_OpenPhases.push_back(s_Phases.size());
+        s_Phases.push_back(phase);
+    }
+
+    void StartupTrace::EndPhase()
+    {
+        if (!s_Recording || s_OpenPhases.empty())
+            return;
+
+        s_Phases[s_OpenPhases.back()].endTicks = os::Time::GetTicks100NanosecondsMonotonic();
+        s_OpenPhases.pop_back();
+    }
+
+    static void AppendJsonString(std::string& json, const char* str)
+    {
+        json += '"';
+        for (const char* c = str; *c != '\0'; c++)
+        {
+            if (*c == '"' || *c == '\\')
+            {
+                json += '\\';
+                json += *c;
+            }
+            else if ((unsigned char)*c < 0x20)
+            {
+                json += utils::StringUtils::Printf("\\u%04x", (unsigned char)*c);
+            }
+            else
+            {
+                json += *c;
+            }
+        }
+        json += '"';
+    }
+
+    bool StartupTrace::Write(const char* path)
+    {
+        if (s_Phases.empty())
+            return false;
+
+        // Timestamps are in microseconds from the start of the first phase. Complete ("X") events on the
+        // same thread nest by time, so the phase hierarchy needs no explicit parent links.
+        const int64_t originTicks = s_Phases[0].startTicks;
+        const int64_t nowTicks = os::Time::GetTicks100NanosecondsMonotonic();
+
+        std::string json;
+        json.reserve(128 * s_Phases.size());
+        json += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        for (size_t i = 0; i < s_Phases.size(); ++i)
+        {
+            const StartupPhase& phase = s_Phases[i];
+            const int64_t endTicks = phase.endTicks != 0 ? phase.endTicks : nowTicks;
+
+            if (i != 0)
+                json += ",\n";
+
+            json += "{\"name\":";
+            AppendJsonString(json, phase.name);
+            json += utils::StringUtils::Printf(",\"cat\":\"il2cpp\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.1f,\"dur\":%.1f",
+                (phase.startTicks - originTicks) / 10.0, (endTicks - phase.startTicks) / 10.0);
+            if (phase.detail != NULL)
+            {
+                json += ",\"args\":{\"detail\":";
+                AppendJsonString(json, phase.detail);
+                json += '}';
+            }
+            json += '}';
+        }
+        json += "\n]}\n";
+
+        int error = 0;
+        os::FileHandle* handle = os::File::Open(path, kFileModeCreate, kFileAccessWrite, kFileShareNone, kFileOptionsNone, &error);
+        if (error != 0)
+            return false;
+
+        int32_t written = os::File::Write(handle, json.c_str(), (int)json.length(), &error);
+        bool success = error == 0 && written == (int32_t)json.length();
+        os::File::Close(handle, &error);
+
+        return success && error == 0;
+    }
+} /* namespace vm */
+} /* namespace il2cpp */
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <stdint.h>
+#include "il2cpp-config.h"
+
+namespace il2cpp
+{
+namespace vm
+{
+    // Records how long the phases of Runtime::Init take, including each eager static constructor and
+    // module initializer, and writes them in the Chrome trace event format (chrome://tracing, Perfetto).
+    // Recording is enabled by il2cpp_set_startup_trace or the IL2CPP_STARTUP_TRACE environment variable,
+    // both naming the file that is written once initialization completes. When recording is disabled a
+    // phase costs a call and a branch.
+    class LIBIL2CPP_CODEGEN_API StartupTrace
+    {
+    public:
+        // Must be called before the runtime is initialized, NULL disables recording even if
+        // IL2CPP_STARTUP_TRACE is set
+        static void SetOutputPath(const char* path);
+
+        // Called at the start of Runtime::Init, starts recording if an output path was set
+        static void Start();
+
+        // Called at the end of Runtime::Init, stops recording and writes the output file if one was set
+        static void Finish();
+
+        // Name and detail must outlive the trace, detail may be NULL
+        static void BeginPhase(const char* name, const char* detail);
+        static void EndPhase();
+
+        // Writes the phases recorded so far, returns false if there are none or the file could not be written
+        static bool Write(const char* path);
+    };
+
+    class StartupTracePhase
+    {
+    public:
+        StartupTracePhase(const char* name, const char* detail = NULL)
+        {
+            StartupTrace::BeginPhase(name, detail);
+        }
+
+        ~StartupTracePhase()
+        {
+            StartupTrace::EndPhase();
+        }
+    };
+} /* namespace vm */
+} /* namespace il2cpp */
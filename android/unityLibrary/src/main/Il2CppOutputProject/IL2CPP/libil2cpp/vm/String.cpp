@@ -10,12 +10,15 @@
 #include "vm/Profiler.h"
 #include "gc/AppendOnlyGCHashMap.h"
 #include "utils/StringUtils.h"
+#include <algorithm>
+#include <limits>
 #include <string>
 #include <memory.h>
 #include "il2cpp-class-internals.h"
 #include "il2cpp-object-internals.h"
 
 #include "Baselib.h"
+#include "Cpp/Atomic.h"
 #include "Cpp/ReentrantLock.h"
 
 namespace il2cpp
@@ -75,9 +78,16 @@ namespace vm
 
     Il2CppString* String::NewLen(const char* str, uint32_t length)
     {
-        UTF16String utf16Chars = il2cpp::utils::StringUtils::Utf8ToUtf16(str, length);
+        // Invalid UTF-8 produces an empty string
+        size_t utf16Length;
+        if (!il2cpp::utils::StringUtils::GetUtf16LengthOfUtf8(str, length, &utf16Length))
+            return Empty();
+
+        Il2CppString* s = NewSize((int32_t)utf16Length);
+        if (utf16Length != 0)
+            il2cpp::utils::StringUtils::TranscodeUtf8ToUtf16(str, length, utils::StringUtils::GetChars(s));
 
-        return NewUtf16(utf16Chars.c_str(), (uint32_t)utf16Chars.length());
+        return s;
     }
 
     Il2CppString* String::NewUtf16(const Il2CppChar* text, int32_t len)
@@ -126,6 +136,98 @@ namespace vm
         return s;
     }
 
+    // Frozen strings live in chunks allocated from the native heap. The GC never sees these chunks, so the
+    // strings cost nothing to mark, and an allocation is a lock free bump of the current chunk's offset.
+    // Strings hold no references to GC memory (the monitor comes from a native free list), so nothing
+    // inside a chunk needs to be scanned either.
+    struct FrozenStringChunk
+    {
+        FrozenStringChunk* next;
+        size_t capacity;
+        baselib::atomic<size_t> used;
+    };
+
+    static const size_t kFrozenStringChunkSize = 64 * 1024;
+    static const size_t kFrozenStringAlignment = 8;
+
+    static baselib::atomic<FrozenStringChunk*> s_FrozenStringChunk;
+    static baselib::ReentrantLock s_FrozenStringChunkLock;
+
+    static inline size_t AlignFrozen(size_t size)
+    {
+        return (size + kFrozenStringAlignment - 1) & ~(kFrozenStringAlignment - 1);
+    }
+
+    static inline uint8_t* FrozenStringChunkData(FrozenStringChunk* chunk)
+    {
+        return reinterpret_cast<uint8_t*>(chunk) + AlignFrozen(sizeof(FrozenStringChunk));
+    }
+
+    static void* AllocateFrozen(size_t size)
+    {
+        size = AlignFrozen(size);
+
+        for (;;)
+        {
+            FrozenStringChunk* chunk = s_FrozenStringChunk.load(baselib::memory_order_acquire);
+            if (chunk != NULL)
+            {
+                size_t offset = chunk->used.fetch_add(size, baselib::memory_order_relaxed);
+                if (offset + size <= chunk->capacity)
+                    return FrozenStringChunkData(chunk) + offset;
+            }
+
+            os::FastAutoLock lock(&s_FrozenStringChunkLock);
+
+            // Another thread may have replaced the chunk while we waited for the lock
+            if (s_FrozenStringChunk.load(baselib::memory_order_relaxed) != chunk)
+                continue;
+
+            size_t capacity = std::max(kFrozenStringChunkSize, size);
+            FrozenStringChunk* newChunk = static_cast<FrozenStringChunk*>(IL2CPP_CALLOC(1, AlignFrozen(sizeof(FrozenStringChunk)) + capacity));
+            if (newChunk == NULL)
+                Exception::RaiseOutOfMemoryException();
+
+            newChunk->next = chunk;
+            newChunk->capacity = capacity;
+            newChunk->used = 0;
+            s_FrozenStringChunk.store(newChunk, baselib::memory_order_release);
+        }
+    }
+
+    Il2CppString* String::NewLenFrozen(const char* str, uint32_t length)
+    {
+        size_t utf16Length;
+        if (!il2cpp::utils::StringUtils::GetUtf16LengthOfUtf8(str, length, &utf16Length))
+            return Empty();
+
+        if (utf16Length == 0)
+            return Empty();
+
+        IL2CPP_ASSERT(utf16Length < static_cast<size_t>(std::numeric_limits<int32_t>::max()));
+
+        // The chunk is zeroed, so the monitor and the null terminator are already set
+        Il2CppString* s = static_cast<Il2CppString*>(AllocateFrozen(sizeof(Il2CppString) + (utf16Length + 1) * 2));
+        s->object.klass = il2cpp_defaults.string_class;
+        s->length = static_cast<int32_t>(utf16Length);
+        il2cpp::utils::StringUtils::TranscodeUtf8ToUtf16(str, length, utils::StringUtils::GetChars(s));
+
+        return s;
+    }
+
+    void String::FreeFrozenStrings()
+    {
+        os::FastAutoLock lock(&s_FrozenStringChunkLock);
+
+        FrozenStringChunk* chunk = s_FrozenStringChunk.exchange(NULL);
+        while (chunk != NULL)
+        {
+            FrozenStringChunk* next = chunk->next;
+            IL2CPP_FREE(chunk);
+            chunk = next;
+        }
+    }
+
     struct InternedString
     {
         int32_t length;
@@ -24,6 +24,10 @@ namespace vm
         static Il2CppString* NewUtf16(const Il2CppChar *text, int32_t len);
         static Il2CppString* NewUtf16(const utils::StringView<Il2CppChar>& text);
 
+        // Allocates an immortal string outside of the GC heap, it is never moved, marked or collected
+        static Il2CppString* NewLenFrozen(const char* str, uint32_t length);
+        static void FreeFrozenStrings();
+
     public:
         static void InitializeEmptyString(Il2CppClass* stringClass);
         static void CleanupEmptyString();
@@ -1,4 +1,5 @@
 #include "il2cpp-config.h"
+#include "os/Atomic.h"
 #include "os/Mutex.h"
 #include "os/Thread.h"
 #include "os/ThreadLocalValue.h"
@@ -400,34 +401,51 @@ namespace vm
         s_MainThread = thread;
     }
 
+    // The thread state is a bitfield that is read on every wait and updated on every transition
+    // into and out of WaitSleepJoin, so it is updated with atomic read-modify-write operations
+    // instead of under synch_cs. Transitions that have to check and set bits together use
+    // TrySetStateUnless.
+
     void Thread::SetState(Il2CppThread *thread, ThreadState value)
     {
-        il2cpp::os::FastAutoLock lock(thread->GetInternalThread()->longlived->synch_cs);
-        thread->GetInternalThread()->state |= value;
+        SetState(thread->GetInternalThread(), value);
     }
 
     void Thread::ClrState(Il2CppInternalThread* thread, ThreadState clr)
     {
-        il2cpp::os::FastAutoLock lock(thread->longlived->synch_cs);
-        thread->state &= ~clr;
+        os::Atomic::FetchAnd(&thread->state, ~(uint32_t)clr);
     }
 
     void Thread::SetState(Il2CppInternalThread *thread, ThreadState value)
     {
-        il2cpp::os::FastAutoLock lock(thread->longlived->synch_cs);
-        thread->state |= value;
+        os::Atomic::FetchOr(&thread->state, (uint32_t)value);
     }
 
     ThreadState Thread::GetState(Il2CppInternalThread *thread)
     {
-        il2cpp::os::FastAutoLock lock(thread->longlived->synch_cs);
-        return (ThreadState)thread->state;
+        return (ThreadState)os::Atomic::LoadAcquire(&thread->state);
     }
 
     bool Thread::TestState(Il2CppInternalThread* thread, ThreadState value)
     {
-        il2cpp::os::FastAutoLock lock(thread->longlived->synch_cs);
-        return (thread->state & value) != 0;
+        return (os::Atomic::LoadAcquire(&thread->state) & value) != 0;
+    }
+
+    // Sets the value bits unless any of the blocking bits are already set. Returns true if this call set them.
+    static bool TrySetStateUnless(Il2CppInternalThread* thread, ThreadState value, uint32_t blocking)
+    {
+        uint32_t state = os::Atomic::LoadAcquire(&thread->state);
+        for (;;)
+        {
+            if (state & blocking)
+                return false;
+
+            uint32_t previous = os::Atomic::CompareExchange(&thread->state, state | value, state);
+            if (previous == state)
+                return true;
+
+            state = previous;
+        }
     }
 
     Il2CppInternalThread* Thread::CurrentInternal()
@@ -437,14 +455,12 @@ namespace vm
 
     ThreadState Thread::GetState(Il2CppThread *thread)
     {
-        il2cpp::os::FastAutoLock lock(thread->GetInternalThread()->longlived->synch_cs);
-        return (ThreadState)thread->GetInternalThread()->state;
+        return GetState(thread->GetInternalThread());
     }
 
     void Thread::ClrState(Il2CppThread* thread, ThreadState state)
     {
-        il2cpp::os::FastAutoLock lock(thread->GetInternalThread()->longlived->synch_cs);
-        thread->GetInternalThread()->state &= ~state;
+        ClrState(thread->GetInternalThread(), state);
     }
 
     static void AllocThreadDataSlot(ThreadStaticData* staticData, ThreadStaticOffset offset, int32_t size)
@@ -702,47 +718,29 @@ namespace vm
 
     bool Thread::RequestAbort(Il2CppThread* thread)
     {
-        il2cpp::os::FastAutoLock lock(thread->GetInternalThread()->longlived->synch_cs);
-
-        ThreadState state = il2cpp::vm::Thread::GetState(thread);
-        if (state & kThreadStateAbortRequested || state & kThreadStateStopped || state & kThreadStateStopRequested)
-            return false;
-
-        il2cpp::os::Thread* osThread = thread->GetInternalThread()->handle;
-        if (osThread)
-        {
-            // If thread has already been started, queue an abort now.
-            Thread::SetState(thread, kThreadStateAbortRequested);
-            osThread->QueueUserAPC(CheckCurrentThreadForAbortCallback, NULL);
-        }
-        else
-        {
-            // If thread has not started, put it in the aborted state.
-            Thread::SetState(thread, kThreadStateAborted);
-        }
-
-        return true;
+        return RequestAbort(thread->GetInternalThread());
     }
 
     bool Thread::RequestAbort(Il2CppInternalThread* thread)
     {
-        il2cpp::os::FastAutoLock lock(thread->longlived->synch_cs);
+        const uint32_t abortBlockingStates = kThreadStateAbortRequested | kThreadStateStopped | kThreadStateStopRequested;
 
-        ThreadState state = il2cpp::vm::Thread::GetState(thread);
-        if (state & kThreadStateAbortRequested || state & kThreadStateStopped || state & kThreadStateStopRequested)
-            return false;
+        // synch_cs keeps the os::Thread alive while the APC is queued, the state transition itself is atomic
+        il2cpp::os::FastAutoLock lock(thread->longlived->synch_cs);
 
         il2cpp::os::Thread* osThread = thread->handle;
         if (osThread)
         {
             // If thread has already been started, queue an abort now.
-            Thread::SetState(thread, kThreadStateAbortRequested);
+            if (!TrySetStateUnless(thread, kThreadStateAbortRequested, abortBlockingStates))
+                return false;
             osThread->QueueUserAPC(CheckCurrentThreadForAbortCallback, NULL);
         }
         else
         {
             // If thread has not started, put it in the aborted state.
-            Thread::SetState(thread, kThreadStateAborted);
+            if (!TrySetStateUnless(thread, kThreadStateAborted, abortBlockingStates))
+                return false;
         }
 
         return true;
@@ -853,7 +851,7 @@ namespace vm
             return NULL;
         }
 
-        internalManagedThread->state &= ~kThreadStateUnstarted;
+        ClrState(internalManagedThread, kThreadStateUnstarted);
 
         startData->m_Semaphore->Post(1, NULL);
 
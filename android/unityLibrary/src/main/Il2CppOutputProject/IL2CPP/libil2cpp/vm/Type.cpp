@@ -5,8 +5,12 @@
 #include <algorithm>
 #include <ctype.h>
 
+#include "gc/GarbageCollector.h"
 #include "gc/WriteBarrier.h"
 #include "metadata/Il2CppTypeCompare.h"
+#include "os/Atomic.h"
+#include "utils/HashUtils.h"
+#include "utils/Il2CppHashMap.h"
 #include "utils/StringUtils.h"
 #include "vm/Assembly.h"
 #include "vm/AssemblyName.h"
@@ -14,6 +18,7 @@
 #include "vm/Field.h"
 #include "vm/GenericClass.h"
 #include "vm/GenericContainer.h"
+#include "vm/MetadataAlloc.h"
 #include "vm/MetadataCache.h"
 #include "vm/Method.h"
 #include "vm/Object.h"
@@ -789,13 +794,105 @@ namespace vm
         }
     }
 
+    static const size_t kTypeNameFormatCount = IL2CPP_TYPE_NAME_FORMAT_REFLECTION_QUALIFIED + 1;
+
+    // Formatted names of one class, by value and by reference. Lives in fixed GC memory so that the
+    // managed strings are reported to the GC; the names themselves live in metadata memory.
+    struct TypeNameCacheEntry
+    {
+        const char* names[2][kTypeNameFormatCount];
+        Il2CppString* strings[2][kTypeNameFormatCount];
+    };
+
+    typedef Il2CppReaderWriterLockedHashMap<Il2CppClass*, TypeNameCacheEntry*> TypeNameCacheMap;
+    static TypeNameCacheMap s_TypeNameCache;
+
+    // The name of a type only depends on its class and on whether it is by reference, so the cache is
+    // keyed on the class rather than on the Il2CppType, which is not unique and may be a temporary
+    static TypeNameCacheEntry* GetTypeNameCacheEntry(const Il2CppType* type)
+    {
+        Il2CppClass* klass = Class::FromIl2CppType(type, false);
+        if (klass == NULL)
+            return NULL;
+
+        TypeNameCacheEntry* entry;
+        if (s_TypeNameCache.TryGet(klass, &entry))
+            return entry;
+
+        TypeNameCacheEntry* newEntry = (TypeNameCacheEntry*)gc::GarbageCollector::AllocateFixed(sizeof(TypeNameCacheEntry), NULL);
+        if (s_TypeNameCache.Add(klass, newEntry))
+            return newEntry;
+
+        gc::GarbageCollector::FreeFixed(newEntry);
+        s_TypeNameCache.TryGet(klass, &entry);
+        return entry;
+    }
+
     std::string Type::GetName(const Il2CppType *type, Il2CppTypeNameFormat format)
     {
+        const char* name = GetCachedName(type, format);
+        if (name != NULL)
+            return name;
+
         std::string str;
         Type::GetNameInternal(str, type, format, false);
         return str;
     }
 
+    const char* Type::GetCachedName(const Il2CppType *type, Il2CppTypeNameFormat format)
+    {
+        IL2CPP_ASSERT(format < kTypeNameFormatCount);
+
+        TypeNameCacheEntry* entry = GetTypeNameCacheEntry(type);
+        if (entry == NULL)
+            return NULL;
+
+        const char** slot = &entry->names[type->byref][format];
+        const char* name = os::Atomic::ReadPointer(slot);
+        if (name != NULL)
+            return name;
+
+        std::string str;
+        Type::GetNameInternal(str, type, format, false);
+
+        char* newName = (char*)MetadataMalloc(str.length() + 1);
+        memcpy(newName, str.c_str(), str.length() + 1);
+
+        // A thread that loses the race leaves its copy behind, metadata memory is only released at shutdown
+        name = os::Atomic::CompareExchangePointer<const char>(slot, newName, NULL);
+        return name != NULL ? name : newName;
+    }
+
+    Il2CppString* Type::GetNameString(const Il2CppType *type, Il2CppTypeNameFormat format)
+    {
+        IL2CPP_ASSERT(format < kTypeNameFormatCount);
+
+        TypeNameCacheEntry* entry = GetTypeNameCacheEntry(type);
+        if (entry == NULL)
+            return String::New(GetName(type, format).c_str());
+
+        Il2CppString** slot = &entry->strings[type->byref][format];
+        Il2CppString* str = os::Atomic::ReadPointer(slot);
+        if (str != NULL)
+            return str;
+
+        Il2CppString* newStr = String::New(GetCachedName(type, format));
+        str = os::Atomic::CompareExchangePointer(slot, newStr, (Il2CppString*)NULL);
+        if (str != NULL)
+            return str;
+
+        gc::GarbageCollector::SetWriteBarrier((void**)slot);
+        return newStr;
+    }
+
+    void Type::ClearNameCache()
+    {
+        for (TypeNameCacheMap::iterator it = s_TypeNameCache.UnlockedBegin(); it != s_TypeNameCache.UnlockedEnd(); it++)
+            gc::GarbageCollector::FreeFixed(it->second);
+
+        s_TypeNameCache.Clear();
+    }
+
     enum
     {
         //max digits on uint16 is 5(used to convert the number of generic args) + max 3 other slots taken;
@@ -1286,14 +1383,117 @@ namespace vm
         return type;
     }
 
-    static void InvokeDelegateConstructor(Il2CppDelegate* delegate, Il2CppObject* target, const MethodInfo* method)
+    typedef Il2CppReaderWriterLockedHashMap<Il2CppClass*, const MethodInfo*> DelegateConstructorMap;
+    static DelegateConstructorMap s_DelegateConstructors;
+
+    // The (object, IntPtr) constructor of a delegate type, looked up by name once per type
+    static const MethodInfo* GetDelegateConstructor(Il2CppClass* delegateClass)
+    {
+        const MethodInfo* ctor;
+        if (s_DelegateConstructors.TryGet(delegateClass, &ctor))
+            return ctor;
+
+        ctor = Class::GetMethodFromName(delegateClass, ".ctor", 2);
+
+        // Another thread may have added the same constructor in the meantime, both are identical
+        s_DelegateConstructors.Add(delegateClass, ctor);
+        return ctor;
+    }
+
+    static void InvokeDelegateConstructor(Il2CppDelegate* delegate, Il2CppObject* target, const MethodInfo* method, const MethodInfo* ctor)
     {
-        typedef void (*DelegateCtor)(Il2CppDelegate* delegate, Il2CppObject* target, intptr_t method, MethodInfo* hiddenMethodInfo);
-        const MethodInfo* ctor = Class::GetMethodFromName(delegate->object.klass, ".ctor", 2);
         void* ctorArgs[2] = {target, (void*)&method};
         ctor->invoker_method(ctor->methodPointer, ctor, delegate, ctorArgs, NULL);
     }
 
+    static void InvokeDelegateConstructor(Il2CppDelegate* delegate, Il2CppObject* target, const MethodInfo* method)
+    {
+        InvokeDelegateConstructor(delegate, target, method, GetDelegateConstructor(delegate->object.klass));
+    }
+
+    // What ConstructDelegate resolves for a delegate type, a method and the class of the target. That is
+    // all the virtual method lookup depends on, except for COM and Windows Runtime objects, whose interface
+    // methods are resolved per object and are never cached
+    struct DelegateBindingKey
+    {
+        const Il2CppClass* delegateClass;
+        const MethodInfo* method;
+        // NULL for delegates created without a target
+        const Il2CppClass* targetClass;
+
+        DelegateBindingKey() : delegateClass(NULL), method(NULL), targetClass(NULL)
+        {
+        }
+
+        DelegateBindingKey(const Il2CppClass* delegateClass_, const MethodInfo* method_, const Il2CppClass* targetClass_) : delegateClass(delegateClass_), method(method_), targetClass(targetClass_)
+        {
+        }
+    };
+
+    struct DelegateBindingKeyHash
+    {
+        size_t operator()(const DelegateBindingKey& key) const
+        {
+            size_t hash = utils::HashUtils::Combine(utils::HashUtils::AlignedPointerHash(key.delegateClass), utils::HashUtils::AlignedPointerHash(key.method));
+            return utils::HashUtils::Combine(hash, utils::HashUtils::AlignedPointerHash(key.targetClass));
+        }
+    };
+
+    struct DelegateBindingKeyEquals
+    {
+        bool operator()(const DelegateBindingKey& left, const DelegateBindingKey& right) const
+        {
+            return left.delegateClass == right.delegateClass && left.method == right.method && left.targetClass == right.targetClass;
+        }
+    };
+
+    struct DelegateBinding
+    {
+        const MethodInfo* ctor;
+        // The method after virtual resolution against the target class
+        const MethodInfo* method;
+        bool methodIsVirtual;
+    };
+
+    typedef Il2CppReaderWriterLockedHashMap<DelegateBindingKey, DelegateBinding, DelegateBindingKeyHash, DelegateBindingKeyEquals> DelegateBindingMap;
+    static DelegateBindingMap s_DelegateBindings;
+
+    static DelegateBinding ResolveDelegateBinding(Il2CppClass* delegateClass, Il2CppObject* target, const MethodInfo* method)
+    {
+        DelegateBinding binding;
+        binding.ctor = GetDelegateConstructor(delegateClass);
+        binding.method = method;
+        binding.methodIsVirtual = false;
+
+        bool isVirtualMethod = method->slot != kInvalidIl2CppMethodSlot && !(method->flags & METHOD_ATTRIBUTE_FINAL);
+        if (isVirtualMethod && target != NULL)
+            binding.method = il2cpp::vm::Object::GetVirtualMethod(target, method);
+        else
+            binding.methodIsVirtual = isVirtualMethod;
+
+        return binding;
+    }
+
+    static DelegateBinding GetDelegateBinding(Il2CppClass* delegateClass, Il2CppObject* target, const MethodInfo* method)
+    {
+        // Interface methods of an RCW are resolved against the COM object itself, so two objects of the
+        // same class can bind to different methods
+        if (target != NULL && target->klass->is_import_or_windows_runtime)
+            return ResolveDelegateBinding(delegateClass, target, method);
+
+        const DelegateBindingKey key(delegateClass, method, target != NULL ? target->klass : NULL);
+
+        DelegateBinding binding;
+        if (s_DelegateBindings.TryGet(key, &binding))
+            return binding;
+
+        binding = ResolveDelegateBinding(delegateClass, target, method);
+
+        // Another thread may have added the same binding in the meantime, both are identical
+        s_DelegateBindings.Add(key, binding);
+        return binding;
+    }
+
 /**
 * Type::ConstructClosedDelegate:
 * @delegate: pointer to an uninitialized delegate object
@@ -1334,14 +1534,18 @@ namespace vm
 
         if (method)
         {
-            bool isVirtualMethod = method->slot != kInvalidIl2CppMethodSlot && !(method->flags & METHOD_ATTRIBUTE_FINAL);
-            if (isVirtualMethod && target != NULL)
-                method = il2cpp::vm::Object::GetVirtualMethod(target, method);
-            else
-                delegate->method_is_virtual = isVirtualMethod;
-        }
+            // The virtual resolution is looked up once per delegate type, method and target class, the
+            // constructor once per delegate type
+            DelegateBinding binding = GetDelegateBinding(delegate->object.klass, target, method);
+            method = binding.method;
+            delegate->method_is_virtual = binding.methodIsVirtual;
 
-        InvokeDelegateConstructor(delegate, target, method);
+            InvokeDelegateConstructor(delegate, target, method, binding.ctor);
+        }
+        else
+        {
+            InvokeDelegateConstructor(delegate, target, method);
+        }
 
         // If we are creating an open delegate on a value type instance method we do not want the adjuster thunk
         // that the ctor will choose, so override it with the direct method
@@ -0,0 +1,164 @@
+#include "il2cpp-config.h"
+#include "il2cpp-class-internals.h"
+#include "os/FastReaderReaderWriterLock.h"
+#include "utils/HashUtils.h"
+#include "utils/Il2CppHashMap.h"
+#include "utils/Memory.h"
+#include "utils/StringUtils.h"
+#include "vm/Image.h"
+#include "vm/Type.h"
+#include "vm/TypeNameCache.h"
+
+#include <string.h>
+#include <vector>
+
+namespace il2cpp
+{
+namespace vm
+{
+    // Bounds the memory used by names that never resolve
+    static const size_t kMaxCachedNames = 4096;
+
+    struct TypeNameCacheKey
+    {
+        const Il2CppChar* name;
+        int32_t length;
+        bool ignoreCase;
+        // Set for names that resolve against the executing image, NULL otherwise
+        const Il2CppImage* image;
+        size_t hash;
+
+        TypeNameCacheKey() : name(NULL), length(0), ignoreCase(false), image(NULL), hash(0)
+        {
+        }
+
+        TypeNameCacheKey(const Il2CppChar* name_, int32_t length_, bool ignoreCase_, const Il2CppImage* image_) :
+            name(name_),
+            length(length_),
+            ignoreCase(ignoreCase_),
+            image(image_),
+            hash(utils::HashUtils::Combine(utils::StringUtils::Hash(name_, length_), utils::HashUtils::AlignedPointerHash(image_)))
+        {
+        }
+    };
+
+    struct TypeNameCacheKeyHash
+    {
+        size_t operator()(const TypeNameCacheKey& key) const
+        {
+            return key.hash;
+        }
+    };
+
+    struct TypeNameCacheKeyEquals
+    {
+        bool operator()(const TypeNameCacheKey& left, const TypeNameCacheKey& right) const
+        {
+            return left.hash == right.hash && left.length == right.length && left.ignoreCase == right.ignoreCase && left.image == right.image &&
+                memcmp(left.name, right.name, left.length * sizeof(Il2CppChar)) == 0;
+        }
+    };
+
+    struct TypeNameCacheEntry
+    {
+        const Il2CppType* type;
+        // The name does not say which assembly it lives in, look it up again keyed by the executing image
+        bool dependsOnExecutingImage;
+    };
+
+    typedef Il2CppHashMap<TypeNameCacheKey, TypeNameCacheEntry, TypeNameCacheKeyHash, TypeNameCacheKeyEquals> TypeNameCacheMap;
+
+    static os::FastReaderReaderWriterLock s_TypeNameCacheLock;
+    static TypeNameCacheMap s_TypeNameCache;
+
+    // Names without an assembly, including generic arguments without one, are first searched for in the
+    // executing image, so the same name can resolve differently depending on the caller
+    static bool UsesExecutingImage(const TypeNameParseInfo& info)
+    {
+        if (info.assembly_name().name.empty())
+            return true;
+
+        const std::vector<TypeNameParseInfo>& typeArguments = info.type_arguments();
+        for (std::vector<TypeNameParseInfo>::const_iterator it = typeArguments.begin(); it != typeArguments.end(); ++it)
+        {
+            if (UsesExecutingImage(*it))
+                return true;
+        }
+
+        return false;
+    }
+
+    static bool TryGetEntry(const TypeNameCacheKey& key, TypeNameCacheEntry* entry)
+    {
+        os::FastReaderReaderWriterAutoSharedLock lock(&s_TypeNameCacheLock);
+
+        TypeNameCacheMap::const_iterator it = s_TypeNameCache.find(key);
+        if (it == s_TypeNameCache.end())
+            return false;
+
+        *entry = it->second;
+        return true;
+    }
+
+    static void FreeKeys()
+    {
+        for (TypeNameCacheMap::iterator it = s_TypeNameCache.begin(); it != s_TypeNameCache.end(); ++it)
+            IL2CPP_FREE(const_cast<Il2CppChar*>(it->first.key.name));
+    }
+
+    static void AddEntry(const TypeNameCacheKey& key, const Il2CppType* type, bool dependsOnExecutingImage)
+    {
+        // Lookups point into the managed string, stored keys need their own copy of the name
+        Il2CppChar* name = static_cast<Il2CppChar*>(IL2CPP_MALLOC(key.length * sizeof(Il2CppChar)));
+        memcpy(name, key.name, key.length * sizeof(Il2CppChar));
+
+        TypeNameCacheKey storedKey = key;
+        storedKey.name = name;
+        TypeNameCacheEntry entry = { type, dependsOnExecutingImage };
+
+        os::FastReaderReaderWriterAutoExclusiveLock lock(&s_TypeNameCacheLock);
+
+        if (s_TypeNameCache.size() >= kMaxCachedNames)
+        {
+            FreeKeys();
+            s_TypeNameCache.clear();
+        }
+
+        if (!s_TypeNameCache.insert(std::make_pair(storedKey, entry)).second)
+            IL2CPP_FREE(name);
+    }
+
+    bool TypeNameCache::TryGet(const Il2CppChar* name, int32_t length, bool ignoreCase, const Il2CppType** type)
+    {
+        TypeNameCacheEntry entry;
+        if (!TryGetEntry(TypeNameCacheKey(name, length, ignoreCase, NULL), &entry))
+            return false;
+
+        if (entry.dependsOnExecutingImage && !TryGetEntry(TypeNameCacheKey(name, length, ignoreCase, Image::GetExecutingImage()), &entry))
+            return false;
+
+        *type = entry.type;
+        return true;
+    }
+
+    void TypeNameCache::Add(const Il2CppChar* name, int32_t length, bool ignoreCase, const TypeNameParseInfo* info, const Il2CppType* type)
+    {
+        if (info != NULL && UsesExecutingImage(*info))
+        {
+            AddEntry(TypeNameCacheKey(name, length, ignoreCase, NULL), NULL, true);
+            AddEntry(TypeNameCacheKey(name, length, ignoreCase, Image::GetExecutingImage()), type, false);
+        }
+        else
+        {
+            AddEntry(TypeNameCacheKey(name, length, ignoreCase, NULL), type, false);
+        }
+    }
+
+    void TypeNameCache::Clear()
+    {
+        os::FastReaderReaderWriterAutoExclusiveLock lock(&s_TypeNameCacheLock);
+        FreeKeys();
+        s_TypeNameCache.clear();
+    }
+} /* namespace vm */
+} /* namespace il2cpp */
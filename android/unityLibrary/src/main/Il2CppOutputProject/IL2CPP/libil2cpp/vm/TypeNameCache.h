@@ -0,0 +1,29 @@
+#pragma once
+
+#include <stdint.h>
+#include "il2cpp-config.h"
+
+struct Il2CppType;
+
+namespace il2cpp
+{
+namespace vm
+{
+    class TypeNameParseInfo;
+
+    // Remembers what Type.GetType resolved a name to, including names that did not resolve, so repeated
+    // lookups of the same name skip parsing and the search through the loaded assemblies.
+    class LIBIL2CPP_CODEGEN_API TypeNameCache
+    {
+    public:
+        // Returns true if the name was resolved before, type is set to NULL if it did not resolve
+        static bool TryGet(const Il2CppChar* name, int32_t length, bool ignoreCase, const Il2CppType** type);
+
+        // info is the parsed name, NULL if it could not be parsed
+        static void Add(const Il2CppChar* name, int32_t length, bool ignoreCase, const TypeNameParseInfo* info, const Il2CppType* type);
+
+        // Called whenever an assembly is registered, it can change what a name resolves to
+        static void Clear();
+    };
+} /* namespace vm */
+} /* namespace il2cpp */